@@ -3,27 +3,6 @@
 #include <cmath>
 
 
-Point2d::Point2d()
-{
-	myx = 0;
-	myy = 0;
-}
-
-
-Point2d::Point2d(const Point2d& otherPoint)
-{
-	this->myx = otherPoint.GetX();
-	this->myy = otherPoint.GetY();
-}
-
-
-Point2d::Point2d(const double x, const double y)
-{
-	this->myx = x;
-	this->myy = y;
-}
-
-
 double Point2d::Distanceof2dPoints(const Point2d p1, const Point2d p2)
 {
 	return sqrt( pow(p1.GetX()-p2.GetX(),2) + pow(p1.GetY()-p2.GetY(),2) );
@@ -43,18 +22,6 @@ double Point2d::Distanceof2dPoints(const Point2d p1, const Point2d p2)
 //}
 
 
-double Point2d::GetX() const
-{
-	return this->myx;
-}
-
-
-double Point2d::GetY() const
-{
-	return this->myy;
-}
-
-
 bool Point2d::operator==(const Point2d& other_point) const
 {
 	if( (this->GetX() == other_point.GetX()) && (this->GetY() == other_point.GetY()) )
@@ -98,17 +65,6 @@ Point2d Point2d::operator-(const Point2d& p1) const
 }
 
 
-Point2d& Point2d::operator=(const Point2d& p)
-{
-	if( this!= &p )
-	{
-		myx = p.myx;
-		myy = p.myy;
-	}
-	return *this;
-}
-
-
 std::ostream& operator<<(std::ostream& output, const Point2d& z)
 {
 	output << "( " << z.GetX() <<" , " << z.GetY() <<" ) ";
@@ -122,4 +122,64 @@ public:
 };
 
 
+/**
+ * The lexicographic order of the points, firstly by x coordinate and then by y coordinate. It is
+ * the order of the Andrew's algorithm (monotone chain) and of the Overmars and van Leeuwen tree,
+ * and it can be the comparator of a std::map or a std::set of points.
+ */
+struct lexicographic_comp{
+	bool operator()(const Point2d& p1, const Point2d& p2) const
+	{
+		return p1.GetX() < p2.GetX() || (p1.GetX() == p2.GetX() && p1.GetY() < p2.GetY());
+	}
+};
+
+
+// the constructors, the accessors and the assignment operator are defined inline because
+// they are called in the inner loops of the sortings and of the convex hull algorithms
+
+inline Point2d::Point2d()
+{
+	myx = 0;
+	myy = 0;
+}
+
+
+inline Point2d::Point2d(const Point2d& otherPoint)
+{
+	this->myx = otherPoint.myx;
+	this->myy = otherPoint.myy;
+}
+
+
+inline Point2d::Point2d(const double x, const double y)
+{
+	this->myx = x;
+	this->myy = y;
+}
+
+
+inline double Point2d::GetX() const
+{
+	return this->myx;
+}
+
+
+inline double Point2d::GetY() const
+{
+	return this->myy;
+}
+
+
+inline Point2d& Point2d::operator=(const Point2d& p)
+{
+	if( this!= &p )
+	{
+		myx = p.myx;
+		myy = p.myy;
+	}
+	return *this;
+}
+
+
 #endif
\ No newline at end of file
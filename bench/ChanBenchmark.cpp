@@ -0,0 +1,113 @@
+/**
+    Purpose: To compare the output-sensitive constructions of the CH2d_dlclist (the Jarvis march and
+    the Chan's algorithm) with the Andrew's algorithm and the quickhull while the size h of the convex
+    hull(2d) grows. The points are the vertices of a regular h-gon and points strictly inside it, so
+    the size of the convex hull(2d) is exactly h.
+    It is compiled from the root of the repository with :
+    g++ -O2 -std=c++11 -Ibasic -Ipreds -Idatastructs bench/ChanBenchmark.cpp basic/Point2d.cpp 
+        basic/Edge2d.cpp preds/Predicates.cpp -o chan_benchmark -pthread
+    and it takes the number of the points as an optional argument (the default is 1000000).
+
+    @author Chaviaras Michalis
+    @version 1.1  6/2018
+*/
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "Point2d.hpp"
+#include "CH2d_dlclist.hpp"
+
+
+
+/**
+ * @param num_points the number of the points
+ * @param h the number of the vertices of the polygon
+ * @returns the vertices of a regular h-gon of radius 1 and num_points-h points strictly inside it,
+ * in random order
+ */
+static std::vector<Point2d> polygon_points(int num_points, int h)
+{
+	const double pi = std::acos(-1.0);
+	std::mt19937_64 gen(12345);
+	std::uniform_real_distribution<double> unif(-1,1);
+	std::vector<Point2d> points;
+	points.reserve(num_points);
+	for( int i = 0; i < h; i++ )
+	{
+		points.push_back(Point2d(std::cos(2*pi*i/h),std::sin(2*pi*i/h)));
+	}
+	//the inscribed circle of the polygon, shrinked a little so the points are strictly inside
+	double radius = 0.999*std::cos(pi/h);
+	while( (int)points.size() < num_points )
+	{
+		double x = unif(gen);
+		double y = unif(gen);
+		if( x*x + y*y < 1 )
+		{
+			points.push_back(Point2d(radius*x,radius*y));
+		}
+	}
+	std::shuffle(points.begin(),points.end(),gen);
+	return points;
+}
+
+
+/**
+ * @returns the seconds of the construction of the convex hull(2d) with the algorithm, the best 
+ * of three runs
+ */
+static double seconds_of(const std::vector<Point2d>& points, const std::string& algorithm, unsigned int& size)
+{
+	double best = 0;
+	for( int run = 0; run < 3; run++ )
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		CH2d_dlclist ch(points,algorithm);
+		double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		size = ch.size();
+		if( run == 0 || sec < best )
+		{
+			best = sec;
+		}
+	}
+	return best;
+}
+
+
+int main(int argc, char* argv[])
+{
+	int num_points = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+	const char* algorithms[] = {"Jarvis","Chan","Andrew","Quickhull"};
+	int sizes[] = {4,8,16,24,32,64,256,1024};
+	std::printf("%6s","h");
+	for( int a = 0; a < 4; a++ )
+	{
+		std::printf("%11s",algorithms[a]);
+	}
+	std::printf("   (seconds, %d points)\n",num_points);
+	for( int s = 0; s < 8; s++ )
+	{
+		std::vector<Point2d> points = polygon_points(num_points,sizes[s]);
+		std::printf("%6d",sizes[s]);
+		for( int a = 0; a < 4; a++ )
+		{
+			unsigned int size;
+			double sec = seconds_of(points,algorithms[a],size);
+			if( (int)size != sizes[s] )
+			{
+				std::printf("\n%s found %u vertices instead of %d\n",algorithms[a],size,sizes[s]);
+				return 1;
+			}
+			std::printf("%11.4f",sec);
+		}
+		std::printf("\n");
+	}
+	return 0;
+}
@@ -7,7 +7,17 @@
 
 
 #include "CompGeomLibrary.hpp"
+#include "CH2d_dynamic.hpp"
+#include "thread_group.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <thread>
 
 
 
@@ -50,19 +60,509 @@ bool comp_edges_by_min_x(const Edge2d& e_1, const Edge2d& e_2) {
 	
 	
 	
-std::list<Point2d> CompGeomLibrary::Compose_ch2d(const std::list< Edge2d > list_of_edges)
+std::list<Point2d> CompGeomLibrary::Compose_ch2d(const std::list< Edge2d >& list_of_edges)
 {
 	// the list we would return, with the vertices of the convex hull in clock wise order
 	std::list<Point2d> conv_hull;
 	
 	// the list_of_edges is const so I take a copy of this and I pro
-	std::list<Point2d> new_list_of_edges(list_of_edges);
+	std::list<Edge2d> new_list_of_edges(list_of_edges);
 	new_list_of_edges.sort(comp_edges_by_min_x);
       
 //at this level I have sorted the input list by the rule I wanted to
+	return conv_hull;
 }
 
 
 
 
 
+
+
+
+
+// the number of the points of a block of the PointsInTheCHMask, it is a multiple of 64 so
+// every block writes whole words of the mask
+static const std::size_t MASK_BLOCK_POINTS = 256;
+
+
+/**
+ * This function is an auxilliary function of the PointsInTheCHMask, it is the work of one thread.
+ * It checks the points in blocks, for every block the same steps of the binary search run for all 
+ * the points of the block without branches.
+ * @param ch the convex hull
+ * @param rel_x the x coordinates of the vertices minus the x coordinate of the first vertex
+ * @param rel_y the y coordinates of the vertices minus the y coordinate of the first vertex
+ * @param points the first point
+ * @param start the position of the first point of the work, a multiple of 64
+ * @param stop the position after the last point of the work
+ * @param mask the first word of the mask
+ */
+static void points_in_fan_blocks(const CH2d_array* ch, const std::vector<double>* rel_x, const std::vector<double>* rel_y,
+                                 const Point2d* points, std::size_t start, std::size_t stop, std::uint64_t* mask)
+{
+	const std::vector<Point2d>* ver = &ch->vertices();
+	int siz = ver->size();
+	if( siz < 3 )
+	{
+		for( std::size_t i = start; i < stop; i++ )
+		{
+			if( i%64 == 0 )
+			{
+				mask[i/64] = 0;
+			}
+			if( ch->contains(points[i]) )
+			{
+				mask[i/64] |= std::uint64_t(1) << (i%64);
+			}
+		}
+		return;
+	}
+	const double* r_x = &(*rel_x)[0];
+	const double* r_y = &(*rel_y)[0];
+	double org_x = (*ver)[0].GetX();
+	double org_y = (*ver)[0].GetY();
+	double p_x[MASK_BLOCK_POINTS];
+	double p_y[MASK_BLOCK_POINTS];
+	int pos[MASK_BLOCK_POINTS];
+	unsigned char inside[MASK_BLOCK_POINTS];
+	for( std::size_t block = start; block < stop; block += MASK_BLOCK_POINTS )
+	{
+		int num = std::min(MASK_BLOCK_POINTS,stop - block);
+		for( int j = 0; j < num; j++ )
+		{
+			p_x[j] = points[block+j].GetX() - org_x;
+			p_y[j] = points[block+j].GetY() - org_y;
+			//between the first and the last edge of the fan
+			inside[j] = (r_x[1]*p_y[j] - r_y[1]*p_x[j] <= 0) & (r_x[siz-1]*p_y[j] - r_y[siz-1]*p_x[j] >= 0);
+			pos[j] = 1;
+		}
+		//the binary search of the wedge, the number of the steps depends only on the size of the convex hull
+		for( int len = siz-2; len > 1; len -= len/2 )
+		{
+			int half = len/2;
+			for( int j = 0; j < num; j++ )
+			{
+				int mid = pos[j] + half;
+				pos[j] = (r_x[mid]*p_y[j] - r_y[mid]*p_x[j] <= 0) ? mid : pos[j];
+			}
+		}
+		//the edge of the convex hull of the wedge
+		for( int j = 0; j < num; j++ )
+		{
+			int i = pos[j];
+			inside[j] &= ((r_x[i+1] - r_x[i])*(p_y[j] - r_y[i]) - (r_y[i+1] - r_y[i])*(p_x[j] - r_x[i]) <= 0);
+		}
+		for( int j = 0; j < num; j += 64 )
+		{
+			std::uint64_t word = 0;
+			for( int k = j; k < std::min(num,j+64); k++ )
+			{
+				word |= std::uint64_t(inside[k]) << (k-j);
+			}
+			mask[(block+j)/64] = word;
+		}
+	}
+}
+
+
+bool CompGeomLibrary::IsPointInTheCH(const CH2d_array& ch, const Point2d& query_po)
+{
+	return ch.contains(query_po);
+}
+
+
+void CompGeomLibrary::PointsInTheCHMask(const CH2d_array& ch, const Point2d* points, std::size_t num_points, std::uint64_t* mask,
+                                        unsigned int num_threads)
+{
+	if( num_threads == 0 )
+	{
+		num_threads = std::max(1u,std::thread::hardware_concurrency());
+	}
+	const std::vector<Point2d>& ver = ch.vertices();
+	std::vector<double> rel_x(ver.size());
+	std::vector<double> rel_y(ver.size());
+	for( std::size_t i = 0; i < ver.size(); i++ )
+	{
+		rel_x[i] = ver[i].GetX() - ver[0].GetX();
+		rel_y[i] = ver[i].GetY() - ver[0].GetY();
+	}
+	//every thread takes a part of whole blocks, so the threads don't write the same words
+	std::size_t num_blocks = (num_points + MASK_BLOCK_POINTS - 1)/MASK_BLOCK_POINTS;
+	std::size_t num_parts = std::max<std::size_t>(1,std::min<std::size_t>(num_threads,num_blocks));
+	if( num_parts == 1 )
+	{
+		points_in_fan_blocks(&ch,&rel_x,&rel_y,points,0,num_points,mask);
+		return;
+	}
+	//the group joins the threads that started if an other thread can't start
+	thread_group threads;
+	for( std::size_t i = 0; i < num_parts; i++ )
+	{
+		std::size_t start = std::min(num_points,num_blocks*i/num_parts*MASK_BLOCK_POINTS);
+		std::size_t stop = std::min(num_points,num_blocks*(i+1)/num_parts*MASK_BLOCK_POINTS);
+		threads.run(std::bind(points_in_fan_blocks,&ch,&rel_x,&rel_y,points,start,stop,mask));
+	}
+	threads.join();
+}
+
+
+std::vector<std::uint64_t> CompGeomLibrary::PointsInTheCHMask(const CH2d_dlclist& ch, const std::vector<Point2d>& points,
+                                                              unsigned int num_threads)
+{
+	std::vector<std::uint64_t> mask((points.size() + 63)/64);
+	if( !points.empty() )
+	{
+		PointsInTheCHMask(CH2d_array(ch),&points[0],points.size(),&mask[0],num_threads);
+	}
+	return mask;
+}
+
+
+std::vector<Point2d> CompGeomLibrary::PointsThatFoundInTheCHfromtheVector(const CH2d_dlclist& ch, const std::vector<Point2d>& points,
+                                                                          unsigned int num_threads)
+{
+	std::vector<std::uint64_t> mask = PointsInTheCHMask(ch,points,num_threads);
+	std::vector<Point2d> inside;
+	for( std::size_t i = 0; i < points.size(); i++ )
+	{
+		if( (mask[i/64] >> (i%64)) & 1 )
+		{
+			inside.push_back(points[i]);
+		}
+	}
+	return inside;
+}
+
+
+/**
+ * This function is an auxilliary function of the RotatingCalipers.
+ * @returns the square of the distance of two points
+ */
+static double squared_distance(const Point2d& p1, const Point2d& p2)
+{
+	double d_x = p1.GetX() - p2.GetX();
+	double d_y = p1.GetY() - p2.GetY();
+	return d_x*d_x + d_y*d_y;
+}
+
+
+/**
+ * This function is an auxilliary function of the RotatingCalipers. The height is |e| times the distance 
+ * from the line of the edge e, it is positive inside the convex hull because it is at the right of the edges.
+ * @param ver the vertices in clockwise order
+ * @param org the first vertex of the edge
+ * @param e_x the x of the edge as a vector
+ * @param e_y the y of the edge as a vector
+ * @param k the vertex, it is taken modulo the number of the vertices
+ */
+static double caliper_height(const std::vector<Point2d>& ver, const Point2d& org, double e_x, double e_y, int k)
+{
+	const Point2d& p = ver[k%ver.size()];
+	return e_y*(p.GetX() - org.GetX()) - e_x*(p.GetY() - org.GetY());
+}
+
+
+/**
+ * This function is an auxilliary function of the RotatingCalipers. The projection is |e| times the 
+ * projection of the vertex on the edge e, the parameters are the same with the caliper_height.
+ */
+static double caliper_projection(const std::vector<Point2d>& ver, const Point2d& org, double e_x, double e_y, int k)
+{
+	const Point2d& p = ver[k%ver.size()];
+	return e_x*(p.GetX() - org.GetX()) + e_y*(p.GetY() - org.GetY());
+}
+
+
+CompGeomLibrary::CalipersResult CompGeomLibrary::RotatingCalipers(const CH2d_array& ch, int measures)
+{
+	CalipersResult res;
+	res.diameter = 0;
+	res.diameter_first = 0;
+	res.diameter_second = 0;
+	res.width = 0;
+	res.width_edge = 0;
+	res.width_vertex = 0;
+	res.rectangle_area = 0;
+	res.rectangle_edge = 0;
+	res.rectangle_top = 0;
+	res.rectangle_first = 0;
+	res.rectangle_last = 0;
+	const std::vector<Point2d>& ver = ch.vertices();
+	int siz = ver.size();
+	if( siz == 0 )
+	{
+		return res;
+	}
+	if( siz < 3 )
+	{
+		//a point or a segment, the width and the area of the rectangle are 0
+		if( measures & CALIPERS_DIAMETER )
+		{
+			res.diameter = std::sqrt(squared_distance(ver[0],ver[siz-1]));
+			res.diameter_second = siz-1;
+		}
+		if( measures & CALIPERS_RECTANGLE )
+		{
+			res.rectangle_top = res.rectangle_last = siz-1;
+			res.rectangle[0] = res.rectangle[3] = ver[0];
+			res.rectangle[1] = res.rectangle[2] = ver[siz-1];
+		}
+		return res;
+	}
+	bool rectangle = (measures & CALIPERS_RECTANGLE) != 0;
+	double max_dist = -1;
+	double min_width = 0;
+	double min_area = 0;
+	//the calipers are counters that only go forward, the vertex is the counter modulo the size :
+	//after the edge i come the last (maximum projection), the top (maximum height) and the first
+	//(minimum projection) in clockwise order
+	int top = 1;
+	int las = 1;
+	int fir = 1;
+	for( int i = 0; i < siz; i++ )
+	{
+		const Point2d& org = ver[i];
+		const Point2d& nex = ver[(i+1)%siz];
+		double e_x = nex.GetX() - org.GetX();
+		double e_y = nex.GetY() - org.GetY();
+		top = std::max(top,i+1);
+		while( caliper_height(ver,org,e_x,e_y,top+1) > caliper_height(ver,org,e_x,e_y,top) )
+		{
+			top++;
+		}
+		double height = caliper_height(ver,org,e_x,e_y,top);
+		double len2 = e_x*e_x + e_y*e_y;
+		if( measures & CALIPERS_DIAMETER )
+		{
+			//the antipodal pairs of the edge, the next vertex of the top is antipodal too if its
+			//edge is parallel to the edge i
+			int num_tops = ( caliper_height(ver,org,e_x,e_y,top+1) == height ) ? 2 : 1;
+			for( int t = top; t < top + num_tops; t++ )
+			{
+				for( int k = i; k <= i+1; k++ )
+				{
+					double dis = squared_distance(ver[k%siz],ver[t%siz]);
+					if( dis > max_dist )
+					{
+						max_dist = dis;
+						res.diameter_first = k%siz;
+						res.diameter_second = t%siz;
+					}
+				}
+			}
+		}
+		if( (measures & CALIPERS_WIDTH) && (i == 0 || height/std::sqrt(len2) < min_width) )
+		{
+			min_width = height/std::sqrt(len2);
+			res.width_edge = i;
+			res.width_vertex = top%siz;
+		}
+		if( rectangle )
+		{
+			las = std::max(las,i+1);
+			while( caliper_projection(ver,org,e_x,e_y,las+1) > caliper_projection(ver,org,e_x,e_y,las) )
+			{
+				las++;
+			}
+			fir = std::max(fir,top);
+			while( caliper_projection(ver,org,e_x,e_y,fir+1) < caliper_projection(ver,org,e_x,e_y,fir) )
+			{
+				fir++;
+			}
+			double area = (caliper_projection(ver,org,e_x,e_y,las) - caliper_projection(ver,org,e_x,e_y,fir))*height/len2;
+			if( i == 0 || area < min_area )
+			{
+				min_area = area;
+				res.rectangle_edge = i;
+				res.rectangle_top = top%siz;
+				res.rectangle_first = fir%siz;
+				res.rectangle_last = las%siz;
+			}
+		}
+	}
+	if( measures & CALIPERS_DIAMETER )
+	{
+		res.diameter = std::sqrt(max_dist);
+	}
+	if( measures & CALIPERS_WIDTH )
+	{
+		res.width = min_width;
+	}
+	if( rectangle )
+	{
+		//the corners from the edge : the sides are on the edge, on the last, on the top and on the first
+		res.rectangle_area = min_area;
+		const Point2d& org = ver[res.rectangle_edge];
+		const Point2d& nex = ver[(res.rectangle_edge+1)%siz];
+		double len = std::sqrt(squared_distance(org,nex));
+		double u_x = (nex.GetX() - org.GetX())/len;
+		double u_y = (nex.GetY() - org.GetY())/len;
+		const Point2d& fir_po = ver[res.rectangle_first];
+		const Point2d& las_po = ver[res.rectangle_last];
+		const Point2d& top_po = ver[res.rectangle_top];
+		double a_min = u_x*(fir_po.GetX() - org.GetX()) + u_y*(fir_po.GetY() - org.GetY());
+		double a_max = u_x*(las_po.GetX() - org.GetX()) + u_y*(las_po.GetY() - org.GetY());
+		double hei = u_y*(top_po.GetX() - org.GetX()) - u_x*(top_po.GetY() - org.GetY());
+		res.rectangle[0] = Point2d(org.GetX() + a_min*u_x, org.GetY() + a_min*u_y);
+		res.rectangle[1] = Point2d(org.GetX() + a_max*u_x, org.GetY() + a_max*u_y);
+		res.rectangle[2] = Point2d(res.rectangle[1].GetX() + hei*u_y, res.rectangle[1].GetY() - hei*u_x);
+		res.rectangle[3] = Point2d(res.rectangle[0].GetX() + hei*u_y, res.rectangle[0].GetY() - hei*u_x);
+	}
+	return res;
+}
+
+
+CompGeomLibrary::CalipersResult CompGeomLibrary::RotatingCalipers(const CH2d_dlclist& ch, int measures)
+{
+	return RotatingCalipers(CH2d_array(ch),measures);
+}
+
+
+/**
+ * This function is an auxilliary function of the BuildCHFromFile, it is the work of the thread 
+ * that reads the next chunk.
+ * @param file the file
+ * @param buffer the buffer of the chunk, two doubles for every point
+ * @param chunk_points the number of the points of a chunk
+ * @param bytes at the end contains the number of the bytes that were read
+ */
+static void read_chunk(std::FILE* file, std::vector<double>* buffer, std::size_t chunk_points, std::size_t* bytes)
+{
+	*bytes = std::fread(&(*buffer)[0],1,chunk_points*2*sizeof(double),file);
+}
+
+
+CompGeomLibrary::StreamStats CompGeomLibrary::BuildCHFromFile(const std::string& file_name, CH2d_dlclist& ch, std::size_t chunk_points)
+{
+	//the file is closed at every exit, also when an exception is thrown
+	std::unique_ptr<std::FILE,int(*)(std::FILE*)> file(std::fopen(file_name.c_str(),"rb"),&std::fclose);
+	if( !file )
+	{
+		throw std::runtime_error( "The file of the points can't be opened : " + file_name );
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	chunk_points = std::max<std::size_t>(1,chunk_points);
+	StreamStats stats;
+	stats.points = 0;
+	stats.bytes = 0;
+	stats.chunks = 0;
+	//two buffers, the thread reads the next chunk to the one while the other is added to the "ch"
+	std::vector<double> buffer(2*chunk_points);
+	std::vector<double> next_buffer(2*chunk_points);
+	std::vector<Point2d> chunk;
+	chunk.reserve(chunk_points);
+	std::size_t bytes = 0;
+	read_chunk(file.get(),&buffer,chunk_points,&bytes);
+	while( bytes > 0 )
+	{
+		std::size_t next_bytes = 0;
+		std::thread reader;
+		bool full = ( bytes == chunk_points*2*sizeof(double) );
+		if( full )
+		{
+			reader = std::thread(read_chunk,file.get(),&next_buffer,chunk_points,&next_bytes);
+		}
+		std::size_t num = bytes/(2*sizeof(double));
+		try
+		{
+			chunk.clear();
+			for( std::size_t i = 0; i < num; i++ )
+			{
+				chunk.push_back(Point2d(buffer[2*i],buffer[2*i+1]));
+			}
+			unsigned int discarded;
+			ch.push_batch(CH2d_dlclist::akl_toussaint_filter(chunk,discarded));
+		}catch( ... )
+		{
+			//the reader must be joined before it is destroyed, else std::terminate is called
+			if( reader.joinable() )
+			{
+				reader.join();
+			}
+			throw;
+		}
+		stats.points += num;
+		stats.bytes += num*2*sizeof(double);
+		stats.chunks++;
+		if( full )
+		{
+			reader.join();
+		}
+		if( bytes%(2*sizeof(double)) != 0 )
+		{
+			throw std::runtime_error( "The size of the file of the points is not a multiple of the size of a point : " + file_name );
+		}
+		buffer.swap(next_buffer);
+		bytes = next_bytes;
+	}
+	if( std::ferror(file.get()) != 0 )
+	{
+		throw std::runtime_error( "The file of the points can't be read : " + file_name );
+	}
+	stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	stats.points_per_second = (stats.seconds > 0) ? stats.points/stats.seconds : 0;
+	stats.bytes_per_second = (stats.seconds > 0) ? stats.bytes/stats.seconds : 0;
+	return stats;
+}
+
+
+/**
+ * This function is an auxilliary function of the ConvexLayers and of the ConvexDepths.
+ * @param points the set of points
+ * @returns the vertices of every layer in clockwise order, from the outermost to the innermost
+ */
+static std::vector< std::vector<Point2d> > peel_layers(const std::vector<Point2d>& points)
+{
+	CH2d_dynamic ch(points);
+	std::vector< std::vector<Point2d> > layers;
+	std::size_t remaining = points.size();
+	while( remaining > 0 )
+	{
+		layers.push_back(ch.vertices());
+		const std::vector<Point2d>& ver = layers.back();
+		for( std::size_t i = 0; i < ver.size(); i++ )
+		{
+			//the same point may be in the set many times, all of them are in this layer
+			while( ch.erase(ver[i]) )
+			{
+				remaining--;
+			}
+		}
+	}
+	return layers;
+}
+
+
+std::vector<CH2d_dlclist> CompGeomLibrary::ConvexLayers(const std::vector<Point2d>& points)
+{
+	std::vector< std::vector<Point2d> > layers = peel_layers(points);
+	std::vector<CH2d_dlclist> res;
+	res.reserve(layers.size());
+	for( std::size_t i = 0; i < layers.size(); i++ )
+	{
+		//the CH2d_dynamic gives the vertices in clockwise order from the head, they are not sorted again
+		res.push_back(CH2d_dlclist::from_clockwise(layers[i]));
+	}
+	return res;
+}
+
+
+std::vector<unsigned int> CompGeomLibrary::ConvexDepths(const std::vector<Point2d>& points)
+{
+	std::vector< std::vector<Point2d> > layers = peel_layers(points);
+	std::map<Point2d,unsigned int,lexicographic_comp> depth_of;
+	for( std::size_t i = 0; i < layers.size(); i++ )
+	{
+		for( std::size_t j = 0; j < layers[i].size(); j++ )
+		{
+			depth_of[layers[i][j]] = i;
+		}
+	}
+	std::vector<unsigned int> depths(points.size());
+	for( std::size_t i = 0; i < points.size(); i++ )
+	{
+		depths[i] = depth_of[points[i]];
+	}
+	return depths;
+}
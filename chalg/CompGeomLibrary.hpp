@@ -11,30 +11,192 @@
 #define COMPGEOMLIBRARY
 
 #include <list>
+#include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 #include "Point2d.hpp"
 #include "Edge2d.hpp"
 #include "CH2d_dlclist.hpp"
+#include "CH2d_array.hpp"
 
 class CompGeomLibrary
 {
 
 public:
 
+/**
+ * The statistics of the BuildCHFromFile.
+ */
+struct StreamStats
+{
+	std::uint64_t points;            // the number of the points that were read
+	std::uint64_t bytes;             // the number of the bytes that were read
+	std::uint64_t chunks;            // the number of the chunks
+	double seconds;                  // the time of the whole building
+	double points_per_second;
+	double bytes_per_second;
+};
+
+
+/**
+ * The measures of the RotatingCalipers, they can be or-ed to ask for many of them.
+ */
+enum CalipersMeasure
+{
+	CALIPERS_DIAMETER = 1,
+	CALIPERS_WIDTH = 2,
+	CALIPERS_RECTANGLE = 4,
+	CALIPERS_ALL = 7
+};
+
+
+/**
+ * The result of the RotatingCalipers. The witnesses are positions of vertices in clockwise order 
+ * from the head (the positions of the CH2d_array), the edge i is the edge from the vertex i to 
+ * the vertex i+1. The measures that were not asked are 0.
+ */
+struct CalipersResult
+{
+	double diameter;                 // the distance of the farthest pair of vertices
+	unsigned int diameter_first;     // the first vertex of the farthest pair
+	unsigned int diameter_second;    // the second vertex of the farthest pair
+	double width;                    // the minimum distance of two parallel lines that support the convex hull
+	unsigned int width_edge;         // the edge that lies on the one line
+	unsigned int width_vertex;       // the vertex that lies on the other line
+	double rectangle_area;           // the area of the minimum-area enclosing rectangle
+	unsigned int rectangle_edge;     // the edge that lies on a side of the rectangle
+	unsigned int rectangle_top;      // the vertex on the side opposite to the edge
+	unsigned int rectangle_first;    // the vertex on the side before the edge
+	unsigned int rectangle_last;     // the vertex on the side after the edge
+	Point2d rectangle[4];            // the corners of the rectangle in clockwise order
+};
+
 /**   
-  @param list_of_edges The unsorted list of the edges of 2d the convex hull 
+  @param list_of_edges The unsorted list of the edges of 2d the convex hull, it is taken by 
+  reference and it is not copied
   @returns A list that contains the vertices of a 2d convex hull in a clockwise order
   @throws exception if there are colinear edges
 */
-static std::list<Point2d> Compose_ch2d(const std::list<Edge2d> list_of_edges);
+static std::list<Point2d> Compose_ch2d(const std::list<Edge2d>& list_of_edges);
 	
 
 /**
  * The following function will search inside the convex hull "ch" which points from the 
  * vector "points" lies inside the "ch".
- *  
+ * The convex hull and the points are taken by reference, they are not copied.
+ * The points on the boundary of the "ch" are inside. The vertices of the "ch" are copied once to 
+ * an array and every point is checked in O(log(h)), see PointsInTheCHMask.
+ * @param num_threads the number of the threads, if it is 0 we use as many threads as the hardware supports
+ * @returns the points that lie inside the "ch" in the order of the vector "points"
+ */
+static std::vector<Point2d> PointsThatFoundInTheCHfromtheVector(const CH2d_dlclist& ch, const std::vector<Point2d>& points, 
+                                                                unsigned int num_threads = 0 );	
+
+
+/**
+ * It checks if a point lies inside the convex hull "ch" or on its boundary, in O(log(h)). 
+ * The vertices make a fan of triangles from the head, a binary search finds the triangle 
+ * (wedge) that may contain the point and the point is checked against its edge of the "ch".
+ * @param ch the convex hull(2d)
+ * @param query_po the point
+ * @returns true if the point lies inside the "ch" or on its boundary
+ */
+static bool IsPointInTheCH(const CH2d_array& ch, const Point2d& query_po);
+
+
+/**
+ * It checks which points lie inside the convex hull "ch" (or on its boundary) and it returns a 
+ * bitmask instead of a copy of the points : the bit (i%64) of the word i/64 is 1 if the i-th point 
+ * lies inside. It is the same with the below function, the vertices of the "ch" are copied once.
+ * @param num_threads the number of the threads, if it is 0 we use as many threads as the hardware supports
+ * @returns the bitmask, it has (number of points + 63)/64 words
+ */
+static std::vector<std::uint64_t> PointsInTheCHMask(const CH2d_dlclist& ch, const std::vector<Point2d>& points,
+                                                    unsigned int num_threads = 0);
+
+
+/**
+ * It checks which points lie inside the convex hull "ch" (or on its boundary) and it writes a 
+ * bitmask : the bit (i%64) of the word mask[i/64] is 1 if the i-th point lies inside.
+ * Purpose : For hundreds of millions of points against a convex hull. The points are checked in 
+ * blocks, the coordinates of a block are copied to two arrays and the binary search of the wedge 
+ * runs for all the points of the block together with the same number of steps and without branches, 
+ * so the compiler can vectorize it. The blocks are shared to the threads. Nothing is allocated for 
+ * the points, the caller gives the memory of the points and of the mask.
+ * @param ch the convex hull(2d)
+ * @param points the first point 
+ * @param num_points the number of the points
+ * @param mask the first word of the mask, it must have (num_points + 63)/64 words
+ * @param num_threads the number of the threads, if it is 0 we use as many threads as the hardware supports
+ */
+static void PointsInTheCHMask(const CH2d_array& ch, const Point2d* points, std::size_t num_points, std::uint64_t* mask,
+                              unsigned int num_threads = 0);
+
+
+/**
+ * It computes the diameter, the width and the minimum-area enclosing rectangle of the convex hull 
+ * "ch" with the rotating calipers, in O(h). For every edge of the "ch" (in clockwise order) three 
+ * calipers are moved forward : the vertex farthest from the line of the edge and the two vertices 
+ * with the maximum and the minimum projection on the edge. A caliper never goes back, so all the 
+ * measures that are asked come out of one sweep. The farthest pair of vertices is an antipodal 
+ * pair, the minimum width has a side on an edge and so does the minimum-area rectangle.
+ * @param ch the convex hull(2d)
+ * @param measures the measures to compute, the CalipersMeasure values or-ed
+ * @returns the measures and their witness vertices
+ */
+static CalipersResult RotatingCalipers(const CH2d_array& ch, int measures = CALIPERS_ALL);
+
+
+/**
+ * It is the same with the above function for a CH2d_dlclist, the vertices are copied once to an 
+ * array, O(h).
+ */
+static CalipersResult RotatingCalipers(const CH2d_dlclist& ch, int measures = CALIPERS_ALL);
+
+
+/**
+ * It builds the convex hull(2d) of the points of a binary file with bounded memory, the file may be 
+ * larger than the memory. The file has the points one after the other, every point is two doubles 
+ * (x and then y) in the byte order of the machine. The file is read in chunks of chunk_points points 
+ * with buffered reads, a thread reads the next chunk while the current chunk is added to the "ch" : 
+ * the Akl-Toussaint filter throws away the most of its points and the rest are pushed as a batch, 
+ * see CH2d_dlclist::push_batch. So the memory is O(chunk_points + h) however large the file is.
+ * @param file_name the name of the file
+ * @param ch the convex hull(2d) that the points are added to, it may have vertices already
+ * @param chunk_points the number of the points of a chunk, 1 << 20 points are 16 MB
+ * @returns the number of the points, of the bytes and of the chunks that were read and the throughput
+ * @throws std::runtime_error if the file can't be opened or read, or if its size is not a multiple 
+ * of the size of a point (the points of the whole chunks before it are already in the "ch")
+ */
+static StreamStats BuildCHFromFile(const std::string& file_name, CH2d_dlclist& ch, std::size_t chunk_points = 1 << 20);
+
+
+/**
+ * It peels the convex layers (the onion layers) of a set of points : the first layer is the convex 
+ * hull(2d) of the points, the second is the convex hull(2d) of the points that are not vertices of 
+ * the first and so on. The points that lie on an edge of a layer but are not vertices of it go to the 
+ * next layers. The CH2d_dynamic of the points is built once in O(n*log(n)) and the vertices of every 
+ * layer are erased from it, every erasure is O(log(n)^2), so the whole peeling is O(n*log(n)^2) 
+ * instead of a construction for every layer. The CH2d_dynamic gives the vertices in clockwise order
+ * from the head, so every layer is linked as it is, without sorting.
+ * The erasures are the most of the time, on one core with uniform random points it is about 
+ * 60ns*n*log2(n)^2 : 0.29s for 25000 points, 1.6s for 100000 and 8.8s for 400000.
+ * @param points the set of points
+ * @returns the layers from the outermost to the innermost
+ */
+static std::vector<CH2d_dlclist> ConvexLayers(const std::vector<Point2d>& points);
+
+
+/**
+ * It is the convex depth of every point, the number of the convex layers before its layer, see the
+ * ConvexLayers. O(n*log(n)^2) as the ConvexLayers.
+ * Purpose : To score the outliers, they have small depth.
+ * @param points the set of points
+ * @returns the depth of every point in the order of the "points", 0 for the vertices of the convex 
+ * hull(2d), the same points have the same depth
  */
-std::vector<Point2d> PointsThatFoundInTheCHfromtheVector(CH2d_dlclist ch, std::vector<Point2d> points );	
+static std::vector<unsigned int> ConvexDepths(const std::vector<Point2d>& points);
 
 
 };
@@ -0,0 +1,431 @@
+/**
+    Purpose: To keep an approximation of the convex hull of a stream of 2d points with constant memory.
+    For k fixed directions (the angles 2*pi*i/k) we keep the point of the stream that goes furthest in
+    every direction, the approximate hull is the convex hull of these extreme points, so it is inside the
+    convex hull(2d) of the stream and it has at most k vertices. Every extreme point of the stream touches
+    a support line of the convex hull in its direction, between two neighbour directions the convex hull
+    may go out of the approximation only inside the triangle of the two support lines and the edge of the
+    two extreme points. The angle of the triangle at the edge is at most 2*pi/k, so its height is at most
+    the half of the edge times tan(pi/k) : the Hausdorff distance of the approximation from the convex
+    hull(2d) is at most (D/2)*tan(pi/k), where D is the diameter of the points.
+    A point that lies inside the approximation (or on its boundary) can't go further than the extreme
+    points in any direction, so it is thrown away with the O(log(k)) wedge test of the CH2d_array. A point
+    outside of it goes further only in the directions that separate it from the approximation, they are
+    an arc around the bisector of its two tangents, so the arc is found in O(log(k)) from the tangents of
+    the CH2d_array and only its directions are updated. The extreme points in the order of the directions
+    are the vertices of the approximation in counter clockwise order (a point may be the extreme of many
+    neighbour directions), so only the chain of the vertices around the arc changes and it is replaced in
+    the CH2d_array in place. For less than 3 vertices, for few directions or if the arc leaves too few
+    directions around it, all the directions are scanned and the approximation is made again from the
+    extreme points, in O(k*log(k)).
+
+    @author Chaviaras Michalis
+    @version 1.1  4/2018
+*/
+#ifndef CH2D_APPROXDEF
+#define CH2D_APPROXDEF
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include "../basic/Point2d.hpp"
+#include "CH2d_dlclist.hpp"
+#include "CH2d_array.hpp"
+
+
+class CH2d_approx{
+private:
+	std::vector<double> my_dir_x;        // the directions as unit vectors
+	std::vector<double> my_dir_y;
+	std::vector<Point2d> my_extremes;    // the point that goes furthest in every direction
+	std::vector<double> my_values;       // the dot product of the extreme point with its direction
+	CH2d_array my_approx;                // the convex hull(2d) of the extreme points
+	unsigned long long my_points_size;   // the number of the points that were pushed
+
+	// with less directions the scan of all of them is faster than the search of the arc, for a stream
+	// of points that are all outside the approximation the two are equal at 16 directions
+	static const unsigned int ARC_MIN_DIRECTIONS = 16;
+
+	/**
+	 * @returns how much the point goes further than the extreme point of the direction i
+	 */
+	double gain(const Point2d& poi, unsigned int i) const
+	{
+		return poi.GetX()*my_dir_x[i] + poi.GetY()*my_dir_y[i] - my_values[i];
+	}
+
+	/**
+	 * The directions of an extreme point are consecutive, so the end of them is found with a binary search.
+	 * @param from a direction
+	 * @param forward true to go counter clockwise (to the next directions), false to go clockwise
+	 * @param limit the maximum number of the directions that are checked
+	 * @returns the number of the consecutive directions from "from" that have the same extreme point,
+	 * "limit" if all the directions up to the limit have it
+	 */
+	unsigned int run_length(unsigned int from, bool forward, unsigned int limit) const
+	{
+		unsigned int num = my_dir_x.size();
+		const Point2d& extreme = my_extremes[from];
+		unsigned int lo = 1;
+		unsigned int hi = limit;
+		while( lo < hi )
+		{
+			unsigned int mid = (lo+hi)/2;
+			unsigned int pos = forward ? (from+mid)%num : (from+num-mid)%num;
+			if( my_extremes[pos] == extreme )
+			{
+				lo = mid+1;
+			}else
+			{
+				hi = mid;
+			}
+		}
+		return lo;
+	}
+
+	/**
+	 * @param poi a vertex of the approximation
+	 * @param dir a direction of which "poi" is the extreme point
+	 * @returns the position of the vertex at the CH2d_array, the size of it if it is not found
+	 */
+	unsigned int vertex_position(const Point2d& poi, unsigned int dir) const
+	{
+		unsigned int siz = my_approx.size();
+		unsigned int pos = my_approx.support(Point2d(my_dir_x[dir],my_dir_y[dir])).index();
+		//an edge may be perpendicular to the direction, then the support is any of its vertices
+		for( unsigned int i = 0; i < 3; i++ )
+		{
+			unsigned int cand = (pos + siz + i - 1)%siz;
+			if( my_approx[cand] == poi )
+			{
+				return cand;
+			}
+		}
+		return siz;
+	}
+
+	/**
+	 * It updates the directions and the approximation for a point outside of it, the approximation must
+	 * have at least 3 vertices.
+	 * The separating directions make the cone of the directions that have negative dot product with the
+	 * vectors from the point to its two tangent vertices, so the nearest direction to its bisector is in
+	 * the arc if the arc has a direction, and the arc grows from it. Around the arc the extreme points in
+	 * clockwise order are ... yss, ys, y, (arc), x, xp, xpp ... and after the update the arc is the point.
+	 * The x and the y are vertices or not depending on the point, the xp and the ys keep their neighbours,
+	 * so they are vertices if they were vertices. One of xp and xpp is a vertex, because only one extreme
+	 * point can lie inside an edge (the edge is perpendicular only to one direction), and the same for ys
+	 * and yss. The chain between these two vertices is made with the monotone chain test and it replaces
+	 * the old chain in the CH2d_array, in O(log(k)) plus the size of the arc and the chains.
+	 * @param query_po the point, it is outside of the approximation
+	 * @param changed it is true if the approximation changed
+	 * @returns false if the arc leaves too few directions around it, then nothing is changed
+	 */
+	bool push_arc(const Point2d& query_po, bool& changed)
+	{
+		unsigned int num = my_dir_x.size();
+		changed = false;
+		CH2d_array::ch_iterator lef, rig;
+		if( !my_approx.tangents(query_po,lef,rig) )
+		{
+			return true;
+		}
+		double u_x = lef->GetX() - query_po.GetX();
+		double u_y = lef->GetY() - query_po.GetY();
+		double w_x = rig->GetX() - query_po.GetX();
+		double w_y = rig->GetY() - query_po.GetY();
+		double len_u = std::sqrt(u_x*u_x + u_y*u_y);
+		double len_w = std::sqrt(w_x*w_x + w_y*w_y);
+		double bis_x = -(u_x/len_u + w_x/len_w);
+		double bis_y = -(u_y/len_u + w_y/len_w);
+		if( bis_x == 0 && bis_y == 0 )
+		{
+			return false;
+		}
+		const double pi = std::acos(-1.0);
+		double angle = std::atan2(bis_y,bis_x);
+		if( angle < 0 )
+		{
+			angle += 2*pi;
+		}
+		unsigned int near = (unsigned int)std::floor(angle/(2*pi)*num + 0.5)%num;
+		//the neighbours are checked too because of the rounding of the angle
+		const unsigned int offsets[3] = {0, num-1, 1};
+		unsigned int mid = num;
+		for( unsigned int i = 0; i < 3 && mid == num; i++ )
+		{
+			unsigned int cand = (near + offsets[i])%num;
+			if( gain(query_po,cand) > 0 )
+			{
+				mid = cand;
+			}
+		}
+		if( mid == num )
+		{
+			return true;
+		}
+		unsigned int before = 0;
+		unsigned int after = 0;
+		while( before+1 < num && gain(query_po,(mid+num-before-1)%num) > 0 )
+		{
+			before++;
+		}
+		while( before+after+1 < num && gain(query_po,(mid+after+1)%num) > 0 )
+		{
+			after++;
+		}
+		unsigned int arc_first = (mid+num-before)%num;
+		unsigned int arc_last = (mid+after)%num;
+		unsigned int free = num - (before+after+1);
+		//the extreme points x, xp, xpp before the arc and y, ys, yss after it
+		unsigned int pos_x = (arc_first+num-1)%num;
+		unsigned int pos_y = (arc_last+1)%num;
+		unsigned int len_x = run_length(pos_x,false,free);
+		unsigned int len_y = run_length(pos_y,true,free);
+		if( len_x + len_y + 4 > free )
+		{
+			return false;
+		}
+		unsigned int pos_xp = (pos_x+num-len_x)%num;
+		unsigned int pos_ys = (pos_y+len_y)%num;
+		unsigned int len_xp = run_length(pos_xp,false,free-len_x-len_y-2);
+		unsigned int len_ys = run_length(pos_ys,true,free-len_x-len_y-len_xp-2);
+		if( len_x + len_xp + len_y + len_ys + 2 >= free )
+		{
+			return false;
+		}
+		unsigned int pos_xpp = (pos_xp+num-len_xp)%num;
+		unsigned int pos_yss = (pos_ys+len_ys)%num;
+		const Point2d& x = my_extremes[pos_x];
+		const Point2d& xp = my_extremes[pos_xp];
+		const Point2d& xpp = my_extremes[pos_xpp];
+		const Point2d& y = my_extremes[pos_y];
+		const Point2d& ys = my_extremes[pos_ys];
+		const Point2d& yss = my_extremes[pos_yss];
+		bool xp_vertex = Predicates::getSignedOrientation(x,xp,xpp) > 0;
+		bool ys_vertex = Predicates::getSignedOrientation(yss,ys,y) > 0;
+		unsigned int first = ys_vertex ? vertex_position(ys,pos_ys) : vertex_position(yss,pos_yss);
+		unsigned int last = xp_vertex ? vertex_position(xp,pos_xp) : vertex_position(xpp,pos_xpp);
+		if( first == my_approx.size() || last == my_approx.size() || first == last )
+		{
+			return false;
+		}
+		//the new chain in clockwise order, the vertices that make a clockwise turn stay
+		std::vector<Point2d> chain;
+		chain.push_back(my_approx[first]);
+		if( !ys_vertex )
+		{
+			chain.push_back(ys);
+		}
+		chain.push_back(y);
+		chain.push_back(query_po);
+		chain.push_back(x);
+		if( !xp_vertex )
+		{
+			chain.push_back(xp);
+		}
+		chain.push_back(my_approx[last]);
+		unsigned int k = 1;
+		for( unsigned int i = 1; i < chain.size(); i++ )
+		{
+			while( k >= 2 && Predicates::getSignedOrientation(chain[k-2],chain[k-1],chain[i]) <= 0 )
+			{
+				k--;
+			}
+			chain[k++] = chain[i];
+		}
+		chain.resize(k-1);
+		chain.erase(chain.begin());
+		for( unsigned int i = 0; i < before+after+1; i++ )
+		{
+			unsigned int pos = (arc_first+i)%num;
+			my_values[pos] = query_po.GetX()*my_dir_x[pos] + query_po.GetY()*my_dir_y[pos];
+			my_extremes[pos] = query_po;
+		}
+		my_approx.replace_chain(first,last,chain);
+		changed = true;
+		return true;
+	}
+
+	/**
+	 * It makes the approximation again from the extreme points, in O(k*log(k)).
+	 */
+	void notify_approx()
+	{
+		//the extreme point of a point is the same for neighbour directions, we keep it once
+		std::vector<Point2d> points;
+		points.reserve(my_extremes.size());
+		for( unsigned int i = 0; i < my_extremes.size(); i++ )
+		{
+			if( points.empty() || !(points.back() == my_extremes[i]) )
+			{
+				points.push_back(my_extremes[i]);
+			}
+		}
+		while( points.size() > 1 && points.back() == points.front() )
+		{
+			points.pop_back();
+		}
+		my_approx = CH2d_array(points,"Andrew");
+	}
+
+public:
+	/**
+	 * @param num_directions the number of the directions k, the error bound is (D/2)*tan(pi/k)
+	 * @throws std::invalid_argument if the number of the directions is less than 3
+	 */
+	explicit CH2d_approx(unsigned int num_directions = 64)
+	{
+		if( num_directions < 3 )
+		{
+			throw std::invalid_argument( "The CH2d_approx needs at least 3 directions" );
+		}
+		const double pi = std::acos(-1.0);
+		my_dir_x.resize(num_directions);
+		my_dir_y.resize(num_directions);
+		for( unsigned int i = 0; i < num_directions; i++ )
+		{
+			my_dir_x[i] = std::cos(2*pi*i/num_directions);
+			my_dir_y[i] = std::sin(2*pi*i/num_directions);
+		}
+		my_points_size = 0;
+	}
+
+	/**
+	 * It pushes a point of the stream, in O(log(k)) if the point lies inside the approximation and
+	 * in O(log(k)) plus the number of the directions and the vertices that it changes otherwise, see
+	 * the purpose of the class.
+	 * @param query_po the point
+	 * @returns true if the approximation changed
+	 */
+	bool push(const Point2d& query_po)
+	{
+		my_points_size++;
+		if( my_approx.size() > 0 && my_approx.contains(query_po) )
+		{
+			return false;
+		}
+		bool changed = false;
+		if( my_approx.size() >= 3 && my_dir_x.size() >= ARC_MIN_DIRECTIONS && push_arc(query_po,changed) )
+		{
+			return changed;
+		}
+		unsigned int num = my_dir_x.size();
+		if( my_extremes.empty() )
+		{
+			my_extremes.assign(num,query_po);
+			my_values.resize(num);
+			for( unsigned int i = 0; i < num; i++ )
+			{
+				my_values[i] = query_po.GetX()*my_dir_x[i] + query_po.GetY()*my_dir_y[i];
+			}
+			notify_approx();
+			return true;
+		}
+		for( unsigned int i = 0; i < num; i++ )
+		{
+			double val = query_po.GetX()*my_dir_x[i] + query_po.GetY()*my_dir_y[i];
+			if( val > my_values[i] )
+			{
+				my_values[i] = val;
+				my_extremes[i] = query_po;
+				changed = true;
+			}
+		}
+		if( changed )
+		{
+			notify_approx();
+		}
+		return changed;
+	}
+
+	/**
+	 * It pushes the points of a range, see push.
+	 * @param first the first point of the range
+	 * @param last the position after the last point of the range
+	 * @returns the number of the points that changed the approximation
+	 */
+	template <class InputIterator>
+	unsigned int push(InputIterator first, InputIterator last)
+	{
+		unsigned int changed = 0;
+		for( ; first != last; ++first )
+		{
+			changed += push(*first);
+		}
+		return changed;
+	}
+
+	/**
+	 * @returns the approximation as a CH2d_array, its vertices are in clockwise order from the
+	 * head as the vertices of the CH2d_dlclist
+	 */
+	const CH2d_array& approx() const
+	{
+		return my_approx;
+	}
+
+	/**
+	 * @returns the approximation as a CH2d_dlclist, in O(k*log(k))
+	 */
+	CH2d_dlclist to_dlclist() const
+	{
+		return CH2d_dlclist(my_approx.vertices(),"Andrew");
+	}
+
+	/**
+	 * It is the bound of the Hausdorff distance of the approximation from the convex hull(2d) of all the
+	 * points that were pushed, see the purpose of the class. It is computed from the edges between the
+	 * extreme points of neighbour directions, so it is never more than (D/2)*tan(pi/k).
+	 * @returns the bound, 0 if no point was pushed
+	 */
+	double error_bound() const
+	{
+		const double pi = std::acos(-1.0);
+		unsigned int num = my_extremes.size();
+		double max_edge = 0;
+		for( unsigned int i = 0; i < num; i++ )
+		{
+			const Point2d& p1 = my_extremes[i];
+			const Point2d& p2 = my_extremes[(i+1)%num];
+			double d_x = p1.GetX() - p2.GetX();
+			double d_y = p1.GetY() - p2.GetY();
+			max_edge = std::max(max_edge,std::sqrt(d_x*d_x + d_y*d_y));
+		}
+		return max_edge/2*std::tan(pi/my_dir_x.size());
+	}
+
+	/**
+	 * @returns the number of the vertices of the approximation, at most k
+	 */
+	unsigned int size() const
+	{
+		return my_approx.size();
+	}
+
+	/**
+	 * @returns the number of the directions k
+	 */
+	unsigned int directions() const
+	{
+		return my_dir_x.size();
+	}
+
+	/**
+	 * @returns the number of the points that were pushed
+	 */
+	unsigned long long points_size() const
+	{
+		return my_points_size;
+	}
+
+	/**
+	 * @returns the area of the approximation, it is at most the area of the convex hull(2d)
+	 */
+	double area() const
+	{
+		return my_approx.area();
+	}
+};
+
+
+#endif
@@ -0,0 +1,663 @@
+/**
+    Purpose: To represent a convex hull of 2d points as the CH2d_dlclist does, but the vertices are kept in
+    one contiguous array in clockwise order, starting from the head (the point with the minimum x and the
+    minimum y). The CH2d_dlclist allocates a node for every vertex and its iterator goes n positions forward
+    following n links, here the iterator goes n positions forward in O(1), so the
+    algorithms that index the vertices (rotating calipers, binary searches) don't pay O(h) for every step
+    and the traversal of the vertices reads contiguous memory.
+    There are two ways to read the vertices : the ch_iterator is the wrap-around view of the CH2d_dlclist,
+    after the last vertex is the head again, with begin() the head and end() the tail. It never reaches an
+    end, so it is only a bidirectional iterator. The vertices_begin() and vertices_end() give the vertices
+    as a plain random access range, from the head to the last vertex in clockwise order, for the algorithms
+    of the standard library.
+    The construction uses the same algorithms as the CH2d_dlclist.
+
+    @author Chaviaras Michalis
+    @version 1.1  2/2018
+*/
+#ifndef CH2D_ARRAYDEF
+#define CH2D_ARRAYDEF
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "../basic/Point2d.hpp"
+#include "../preds/Predicates.hpp"
+#include "CH2d_dlclist.hpp"
+
+
+class CH2d_array{
+	// the CH2d_approx changes only the chain of the vertices that a new point affects
+	friend class CH2d_approx;
+private:
+	std::vector<Point2d> my_points;  // the vertices in clockwise order, my_points[my_head] is the head
+	unsigned int my_head;            // the position of the head, it is always 0
+	unsigned int my_tail;            // the position of the tail
+	double my_area;
+
+	/**
+	 * It sets the vertices, the tail and the area.
+	 * @param ch_points the vertices of the convex hull(2d) in clockwise order starting from
+	 * the point with the minimum x and the minimum y
+	 */
+	void set_points(const std::vector<Point2d>& ch_points)
+	{
+		my_points = ch_points;
+		my_head = 0;
+		my_tail = 0;
+		int siz = my_points.size();
+		for( int i = 1; i < siz; i++ )
+		{
+			//the tail is the point with the maximum x and the minimum y, with two points
+			//the tail is the point that is not the head as the CH2d_dlclist does.
+			if( siz == 2 || my_points[i].GetX() > my_points[my_tail].GetX() ||
+			    (my_points[i].GetX() == my_points[my_tail].GetX() && my_points[i].GetY() < my_points[my_tail].GetY()) )
+			{
+				my_tail = i;
+			}
+		}
+		notify_area();
+	}
+
+	/**
+	 * It calculates the area with the triangles from the head, in O(size of convex hull).
+	 */
+	void notify_area()
+	{
+		my_area = 0;
+		for( int i = 1; i+1 < (int)my_points.size(); i++ )
+		{
+			my_area += std::abs(Predicates::getSignedOrientation(my_points[i],my_points[0],my_points[i+1]))/2.0;
+		}
+	}
+
+	/**
+	 * The comparison of the support query, the vertex i is greater than the vertex j if it goes
+	 * further in the direction.
+	 */
+	struct support_comp{
+		const Point2d* ver;
+		double dir_x;
+		double dir_y;
+		int operator()(int i, int j) const
+		{
+			double dot = (ver[i].GetX() - ver[j].GetX())*dir_x + (ver[i].GetY() - ver[j].GetY())*dir_y;
+			return (dot > 0) - (dot < 0);
+		}
+	};
+
+	/**
+	 * The comparison of the tangent query, the vertex i is greater than the vertex j if it is
+	 * counterclockwise of the j as we see them from the point. For a point outside of the convex
+	 * hull the vertices are in a cone of angle less than pi so the order is a total order.
+	 */
+	struct tangent_comp{
+		const Point2d* ver;
+		Point2d from;
+		bool reverse;
+		int operator()(int i, int j) const
+		{
+			double ori = Predicates::getSignedOrientation(ver[j],from,ver[i]);
+			int sig = (ori > 0) - (ori < 0);
+			return reverse ? -sig : sig;
+		}
+	};
+
+	/**
+	 * It finds the maximum vertex of an order that is unimodal around the convex hull, it goes up from
+	 * the minimum to the maximum and down to the minimum again, in O(log(h)) comparisons. Two neighbours
+	 * may be equal only at the maximum or at the minimum, then any of the two is returned.
+	 * @param comp the comparison, comp(i,j) is 1 if the vertex i is greater than the vertex j, 0 if they
+	 * are equal and -1 otherwise
+	 * @returns the position of the maximum vertex
+	 */
+	template <class Comp>
+	unsigned int unimodal_max(const Comp& comp) const
+	{
+		int siz = my_points.size();
+		if( siz < 3 )
+		{
+			return ( siz == 2 && comp(1,0) > 0 ) ? 1 : 0;
+		}
+		if( comp(siz-1,0) <= 0 && comp(1,0) <= 0 )
+		{
+			return 0;
+		}
+		//the maximum is always in (lo,hi), hi is siz at the start that is the position 0 again
+		int lo = 0;
+		int hi = siz;
+		bool lo_up = comp(1,0) > 0;
+		while( hi - lo > 1 )
+		{
+			int mid = (lo+hi)/2;
+			int aft = (mid+1 == siz) ? 0 : mid+1;
+			bool mid_up = comp(aft,mid) > 0;
+			if( !mid_up && comp(mid-1,mid) <= 0 )
+			{
+				return mid;
+			}
+			//from the lo it goes up to the maximum, down to the minimum and up again to the hi
+			//if lo_up, or down to the minimum, up to the maximum and down again to the hi if not
+			bool before_max;
+			if( lo_up )
+			{
+				before_max = mid_up && comp(mid,lo) > 0;
+			}else
+			{
+				before_max = mid_up || comp(mid,lo) <= 0;
+			}
+			if( before_max )
+			{
+				lo = mid;
+				lo_up = mid_up;
+			}else
+			{
+				hi = mid;
+			}
+		}
+		return lo;
+	}
+
+	/**
+	 * It is the tangent query with positions in the array.
+	 * @returns false if the point lies inside the convex hull(2d) or on its boundary
+	 */
+	bool tangent_positions(const Point2d& query_po, unsigned int& left, unsigned int& right) const
+	{
+		if( my_points.empty() || contains(query_po) )
+		{
+			return false;
+		}
+		tangent_comp comp;
+		comp.ver = &my_points[0];
+		comp.from = query_po;
+		comp.reverse = false;
+		left = unimodal_max(comp);
+		comp.reverse = true;
+		right = unimodal_max(comp);
+		return true;
+	}
+
+	/**
+	 * @returns the area of the convex polygon of the vertices "first", the vertices of "chain" and "last",
+	 * with the triangles from "first"
+	 */
+	static double chain_area(const Point2d& first, const std::vector<Point2d>& chain, const Point2d& last)
+	{
+		double res = 0;
+		for( int i = 0; i < (int)chain.size(); i++ )
+		{
+			const Point2d& next = (i+1 < (int)chain.size()) ? chain[i+1] : last;
+			res += std::abs(Predicates::getSignedOrientation(chain[i],first,next))/2.0;
+		}
+		return res;
+	}
+
+	/**
+	 * @returns the area of the convex polygon of the vertices from the position "first" to the position
+	 * "last" in clockwise order, with the triangles from "first"
+	 */
+	double chain_area(unsigned int first, unsigned int last) const
+	{
+		unsigned int siz = my_points.size();
+		double res = 0;
+		for( unsigned int i = (first+1)%siz; i != last; i = (i+1)%siz )
+		{
+			res += std::abs(Predicates::getSignedOrientation(my_points[i],my_points[first],my_points[(i+1)%siz]))/2.0;
+		}
+		return res;
+	}
+
+	/**
+	 * It replaces the vertices that are strictly between two vertices in clockwise order with a new
+	 * chain, the result must be convex. The area, the head and the tail are updated from the two chains
+	 * in O(size of the chains) and the array is changed in place with one move of the vertices after
+	 * the chain, only if the head changes or the chain passes over the end of the array it is rotated.
+	 * @param first the position of the vertex before the chain
+	 * @param last the position of the vertex after the chain, it is not "first"
+	 * @param chain the new vertices between them in clockwise order
+	 */
+	void replace_chain(unsigned int first, unsigned int last, const std::vector<Point2d>& chain)
+	{
+		unsigned int siz = my_points.size();
+		assert( first != last && first < siz && last < siz );
+		unsigned int removed = (last + siz - first - 1)%siz;
+		my_area += chain_area(my_points[first],chain,my_points[last]) - chain_area(first,last);
+		//the head and the tail are the old ones if they are not removed or a vertex of the chain
+		Point2d head = my_points[my_head];
+		Point2d tail = my_points[my_tail];
+		bool head_removed = (my_head + siz - first - 1)%siz < removed;
+		bool tail_removed = (my_tail + siz - first - 1)%siz < removed;
+		int head_chain = -1;
+		int tail_chain = -1;
+		for( int i = 0; i < (int)chain.size(); i++ )
+		{
+			const Point2d& p = chain[i];
+			if( (head_removed && head_chain < 0) || p.GetX() < head.GetX() || (p.GetX() == head.GetX() && p.GetY() < head.GetY()) )
+			{
+				head = p;
+				head_chain = i;
+			}
+			if( (tail_removed && tail_chain < 0) || p.GetX() > tail.GetX() || (p.GetX() == tail.GetX() && p.GetY() < tail.GetY()) )
+			{
+				tail = p;
+				tail_chain = i;
+			}
+		}
+		if( first < last && head_chain < 0 )
+		{
+			//the chain is inside the array and the head stays at the position 0
+			unsigned int common = std::min<unsigned int>(removed,chain.size());
+			std::copy(chain.begin(),chain.begin()+common,my_points.begin()+first+1);
+			if( removed > common )
+			{
+				my_points.erase(my_points.begin()+first+1+common,my_points.begin()+last);
+			}else
+			{
+				my_points.insert(my_points.begin()+last,chain.begin()+common,chain.end());
+			}
+			if( tail_chain >= 0 )
+			{
+				my_tail = first + 1 + tail_chain;
+			}else if( my_tail >= last )
+			{
+				my_tail = my_tail + chain.size() - removed;
+			}
+			return;
+		}
+		//the vertices from "last" to "first" and the chain, rotated to start from the head
+		std::vector<Point2d> points;
+		points.reserve(siz - removed + chain.size());
+		for( unsigned int i = last; points.size() < siz - removed; i = (i+1)%siz )
+		{
+			points.push_back(my_points[i]);
+		}
+		unsigned int kept = points.size();
+		points.insert(points.end(),chain.begin(),chain.end());
+		unsigned int new_head = (head_chain >= 0) ? kept + head_chain : (my_head + siz - last)%siz;
+		unsigned int new_tail = (tail_chain >= 0) ? kept + tail_chain : (my_tail + siz - last)%siz;
+		std::rotate(points.begin(),points.begin()+new_head,points.end());
+		my_points.swap(points);
+		my_head = 0;
+		my_tail = (new_tail + my_points.size() - new_head)%my_points.size();
+	}
+
+public:
+	/**
+	 * The iterator of the wrap-around view, it goes in clockwise order and after the last vertex is
+	 * the head again. It is a bidirectional iterator because a cyclic position has no order and no
+	 * distance, the operator+ and the operator- go n positions forward or backward in O(1) as the
+	 * ones of the CH2d_dlclist go following the links. For the random access use the vertices_begin().
+	 */
+	class ch_iterator{
+	private:
+		const Point2d* arr;
+		std::ptrdiff_t siz;
+		std::ptrdiff_t pos;
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef Point2d value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const Point2d* pointer;
+		typedef const Point2d& reference;
+
+		ch_iterator(){arr = 0; siz = 0; pos = 0;}
+		ch_iterator(const Point2d* a, std::ptrdiff_t s, std::ptrdiff_t x) {arr = a; siz = s; pos = x;}
+		ch_iterator(const ch_iterator& other_it) {arr = other_it.arr; siz = other_it.siz; pos = other_it.pos;}
+		ch_iterator& operator=(const ch_iterator& other_ch_it){arr = other_ch_it.arr; siz = other_ch_it.siz; pos = other_ch_it.pos; return *this;}
+		ch_iterator& operator++() {if( ++pos == siz ) pos = 0; return *(this);}
+		ch_iterator operator++(int) {ch_iterator tmp(*(this)); operator++(); return tmp; }
+		ch_iterator& operator--() {if( pos-- == 0 ) pos = siz-1; return *(this);}
+		ch_iterator operator--(int) {ch_iterator tmp(*(this)); operator--(); return tmp; }
+		ch_iterator operator+(std::ptrdiff_t num) const {ch_iterator tmp(*(this)); if( siz > 0 ) tmp.pos = ((pos+num)%siz + siz)%siz; return tmp;}
+		ch_iterator operator-(std::ptrdiff_t num) const {return operator+(-num);}
+		bool operator==(const ch_iterator& other_it) const {return arr == other_it.arr && pos == other_it.pos;}
+		bool operator!=(const ch_iterator& other_it) const {return !(*this == other_it);}
+		//the returned type is a const reference because I don't want to change the data of the array
+		//from the iterator
+		const Point2d& operator*() const {return arr[pos];}
+		const Point2d* operator->() const {return arr + pos;}
+		/**
+		 * @returns the position of the vertex in the array, the head is at the position 0
+		 */
+		std::ptrdiff_t index() const {return pos;}
+	};
+
+	typedef std::vector<Point2d>::const_iterator vertex_iterator;
+
+	/**
+	 *   Default Constructor
+	 */
+	CH2d_array()
+	{
+		my_head = 0;
+		my_tail = 0;
+		my_area = 0;
+	}
+
+	/**
+	 * It makes the convex hull(2d) with the same algorithms as the CH2d_dlclist.
+	 * @param all_points The set of points of which we will build the convex hull(2d)
+	 * @param algorithm The algorithm we will use to construct the convex hull(2d), see
+	 * the CH2d_dlclist
+	 * @param prefilter if it is true the points pass from the akl_toussaint_filter before
+	 * the algorithm runs
+	 * @param num_threads the number of the threads of the "Parallel" algorithm, if it is 0
+	 * we use as many threads as the hardware supports
+	 * @throws std::invalid_argument if the algorithm is unknown
+	 */
+	CH2d_array(const std::vector<Point2d>& all_points, std::string algorithm = "Auto", bool prefilter = false,
+	           unsigned int num_threads = 0)
+	{
+		std::vector<Point2d> survivors;
+		if( prefilter )
+		{
+			unsigned int discarded;
+			survivors = CH2d_dlclist::akl_toussaint_filter(all_points,discarded);
+		}
+		const std::vector<Point2d>& points = prefilter ? survivors : all_points;
+		if( algorithm.compare("Auto") == 0 )
+		{
+			algorithm = "Andrew";
+		}
+		if( algorithm.compare("Jarvis") == 0 )
+		{
+			//the Jarvis march makes the list of the vertices, it is used for few points
+			CH2d_dlclist ch(points,"Jarvis");
+			*this = CH2d_array(ch);
+		}else if( algorithm.compare("Andrew") == 0 )
+		{
+			set_points(CH2d_dlclist::monotone_chain(points));
+		}else if( algorithm.compare("Chan") == 0 )
+		{
+			set_points(points.size() < 3 ? CH2d_dlclist::monotone_chain(points) : CH2d_dlclist::chan(points));
+		}else if( algorithm.compare("Parallel") == 0 )
+		{
+			set_points(points.size() < 3 ? CH2d_dlclist::monotone_chain(points) : CH2d_dlclist::parallel_hull(points,num_threads));
+		}else if( algorithm.compare("Quickhull") == 0 )
+		{
+			set_points(points.size() < 3 ? CH2d_dlclist::monotone_chain(points) : CH2d_dlclist::quickhull(points));
+		}else
+		{
+			throw std::invalid_argument( "Unknown algorithm for the construction of the CH2d_array : " + algorithm );
+		}
+	}
+
+	/**
+	 * It copies the vertices of a CH2d_dlclist, O(size of convex hull).
+	 * @param other_ch the CH2d_dlclist of which the "this" will be a copy of
+	 */
+	explicit CH2d_array(const CH2d_dlclist& other_ch)
+	{
+		my_head = 0;
+		my_tail = 0;
+		my_area = other_ch.area();
+		if( other_ch.size() > 0 )
+		{
+			my_points.reserve(other_ch.size());
+			CH2d_dlclist::ch_iterator it = other_ch.begin();
+			for( unsigned int i = 0; i < other_ch.size(); i++, ++it )
+			{
+				if( it == other_ch.end() )
+				{
+					my_tail = i;
+				}
+				my_points.push_back(*it);
+			}
+		}
+	}
+
+	/**
+	 * It pushes a point, if it is not interior to the convex hull(2d), in O(size of convex hull)
+	 * reading only contiguous memory. The vertices are merged with the point in lexicographic order
+	 * and the monotone chain makes the new convex hull(2d). The iterators are not valid after a push
+	 * that adds the point.
+	 * @param query_po Is the point that maybe added to the array.
+	 * @returns -1 if the point wasn't added to the array, 1 if the point was added to the array.
+	 */
+	int push(const Point2d& query_po)
+	{
+		for( int i = 0; i < (int)my_points.size(); i++ )
+		{
+			if( my_points[i] == query_po )
+			{
+				return -1;
+			}
+		}
+		std::vector<Point2d> single(1,query_po);
+		std::vector<Point2d> ch_points = CH2d_dlclist::merge_hulls(my_points,single);
+		bool added = false;
+		for( int i = 0; i < (int)ch_points.size() && !added; i++ )
+		{
+			added = (ch_points[i] == query_po);
+		}
+		if( !added )
+		{
+			return -1;
+		}
+		set_points(ch_points);
+		return 1;
+	}
+
+	/**
+	 * @returns the number of the points consistute the convex hull
+	 */
+	unsigned int size() const
+	{
+		return my_points.size();
+	}
+
+	/**
+	 * @returns the point with the minimum x and the minimum y
+	 */
+	ch_iterator begin() const
+	{
+		assert( my_points.size() > 0 );
+		return ch_iterator(&my_points[0],my_points.size(),my_head);
+	}
+
+	/**
+	 * @returns the point with the maximum x, and the minimum y
+	 */
+	ch_iterator end() const
+	{
+		assert( my_points.size() > 0 );
+		return ch_iterator(&my_points[0],my_points.size(),my_tail);
+	}
+
+	/**
+	 * @returns the first vertex of the array, the head
+	 */
+	vertex_iterator vertices_begin() const
+	{
+		return my_points.begin();
+	}
+
+	/**
+	 * @returns the position after the last vertex of the array
+	 */
+	vertex_iterator vertices_end() const
+	{
+		return my_points.end();
+	}
+
+	/**
+	 * @returns the vertex at the position num in clockwise order from the head, the position
+	 * is taken modulo the size so it can be any integer
+	 */
+	const Point2d& operator[](std::ptrdiff_t num) const
+	{
+		assert( my_points.size() > 0 );
+		std::ptrdiff_t siz = my_points.size();
+		return my_points[((num%siz)+siz)%siz];
+	}
+
+	/**
+	 * @returns the position of the head in the array
+	 */
+	unsigned int head_index() const
+	{
+		return my_head;
+	}
+
+	/**
+	 * @returns the position of the tail in the array
+	 */
+	unsigned int tail_index() const
+	{
+		return my_tail;
+	}
+
+	/**
+	 * @returns the vertices in clockwise order from the head
+	 */
+	const std::vector<Point2d>& vertices() const
+	{
+		return my_points;
+	}
+
+	/**
+	 * @returns the area of the convex hull(2d)
+	 */
+	double area() const
+	{
+		return my_area;
+	}
+
+	/**
+	 * It checks if a point lies inside the convex hull(2d) or on its boundary, in O(log(h)). The vertices
+	 * make a fan of triangles from the head, a binary search finds the triangle (wedge) that may contain
+	 * the point and the point is checked against its edge of the convex hull.
+	 * @param query_po the point
+	 * @returns true if the point lies inside the convex hull(2d) or on its boundary
+	 */
+	bool contains(const Point2d& query_po) const
+	{
+		const std::vector<Point2d>& ver = my_points;
+		int siz = ver.size();
+		if( siz == 0 )
+		{
+			return false;
+		}else if( siz == 1 )
+		{
+			return ver[0].GetX() == query_po.GetX() && ver[0].GetY() == query_po.GetY();
+		}else if( siz == 2 )
+		{
+			return Predicates::getSignedOrientation(ver[0],query_po,ver[1]) == 0 &&
+			       std::min(ver[0].GetX(),ver[1].GetX()) <= query_po.GetX() && query_po.GetX() <= std::max(ver[0].GetX(),ver[1].GetX()) &&
+			       std::min(ver[0].GetY(),ver[1].GetY()) <= query_po.GetY() && query_po.GetY() <= std::max(ver[0].GetY(),ver[1].GetY());
+		}
+		double p_x = query_po.GetX() - ver[0].GetX();
+		double p_y = query_po.GetY() - ver[0].GetY();
+		//the vertices are in clockwise order so the inside is at the right of the edges, the point
+		//must be between the first and the last edge of the fan
+		if( (ver[1].GetX() - ver[0].GetX())*p_y - (ver[1].GetY() - ver[0].GetY())*p_x > 0 ||
+		    (ver[siz-1].GetX() - ver[0].GetX())*p_y - (ver[siz-1].GetY() - ver[0].GetY())*p_x < 0 )
+		{
+			return false;
+		}
+		//the last vertex i of the fan that has the point at the right of (or on) the ray from the first
+		//vertex to it, the point is in the wedge of the i and i+1
+		int lo = 1;
+		int hi = siz-2;
+		while( lo < hi )
+		{
+			int mid = (lo+hi+1)/2;
+			if( (ver[mid].GetX() - ver[0].GetX())*p_y - (ver[mid].GetY() - ver[0].GetY())*p_x <= 0 )
+			{
+				lo = mid;
+			}else
+			{
+				hi = mid-1;
+			}
+		}
+		return Predicates::getSignedOrientation(ver[lo+1],ver[lo],query_po) <= 0;
+	}
+
+	/**
+	 * It finds the vertex that goes furthest in a direction (the support function of the convex
+	 * hull), in O(log(h)) with a binary search over the vertices.
+	 * @param direction the direction as a vector, it must not be (0,0)
+	 * @returns the vertex with the maximum dot product with the direction, if an edge is perpendicular
+	 * to the direction any of its two vertices
+	 */
+	ch_iterator support(const Point2d& direction) const
+	{
+		assert( my_points.size() > 0 );
+		support_comp comp;
+		comp.ver = &my_points[0];
+		comp.dir_x = direction.GetX();
+		comp.dir_y = direction.GetY();
+		return ch_iterator(&my_points[0],my_points.size(),unimodal_max(comp));
+	}
+
+	/**
+	 * The support query for many directions, every query is O(log(h)).
+	 * @param directions the directions
+	 * @returns the position in the array of the support vertex of every direction
+	 */
+	std::vector<unsigned int> support(const std::vector<Point2d>& directions) const
+	{
+		assert( my_points.size() > 0 );
+		std::vector<unsigned int> result(directions.size());
+		support_comp comp;
+		comp.ver = &my_points[0];
+		for( std::size_t i = 0; i < directions.size(); i++ )
+		{
+			comp.dir_x = directions[i].GetX();
+			comp.dir_y = directions[i].GetY();
+			result[i] = unimodal_max(comp);
+		}
+		return result;
+	}
+
+	/**
+	 * It finds the two vertices of the tangents from a point outside of the convex hull(2d), in O(log(h)).
+	 * As we see the convex hull from the point, the left tangent vertex has all the convex hull at the
+	 * right of (or on) the ray from the point to it and the right tangent vertex at the left. If the point
+	 * is on the line of an edge the nearest vertex of the edge is not certain to be returned, any of the
+	 * two may be.
+	 * @param query_po the point
+	 * @param left the vertex of the left tangent, it doesn't change if there are no tangents
+	 * @param right the vertex of the right tangent, it doesn't change if there are no tangents
+	 * @returns false if the point lies inside the convex hull(2d) or on its boundary, so there are no
+	 * tangents, true otherwise
+	 */
+	bool tangents(const Point2d& query_po, ch_iterator& left, ch_iterator& right) const
+	{
+		unsigned int lef, rig;
+		if( !tangent_positions(query_po,lef,rig) )
+		{
+			return false;
+		}
+		left = ch_iterator(&my_points[0],my_points.size(),lef);
+		right = ch_iterator(&my_points[0],my_points.size(),rig);
+		return true;
+	}
+
+	/**
+	 * The tangent query for many points, every query is O(log(h)).
+	 * @param points the points
+	 * @param left the position in the array of the left tangent vertex of every point, it is the
+	 * size of the convex hull for the points inside of it or on its boundary
+	 * @param right the position in the array of the right tangent vertex of every point, it is the
+	 * size of the convex hull for the points inside of it or on its boundary
+	 */
+	void tangents(const std::vector<Point2d>& points, std::vector<unsigned int>& left, std::vector<unsigned int>& right) const
+	{
+		left.assign(points.size(),my_points.size());
+		right.assign(points.size(),my_points.size());
+		for( std::size_t i = 0; i < points.size(); i++ )
+		{
+			tangent_positions(points[i],left[i],right[i]);
+		}
+	}
+};
+
+
+#endif
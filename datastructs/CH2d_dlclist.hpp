@@ -6,6 +6,9 @@
     current convex hull. So this class provide a unified way to read the points and to add a point keeping in mind that
     this list would represent a convex hul of 2d points, i.e you can't add a point to the list which is not a vertex of
     the convex hull.
+    The "Parallel" construction uses std::thread, so the programs that use it must be linked
+    with the thread library (-pthread). The "Quickhull" construction uses AVX2 instructions if 
+    it is compiled with them (-mavx2), otherwise it uses the same code without them.
 
     
 
@@ -19,8 +22,20 @@
 #include <cmath>
 #include <vector>
 #include <stack>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <thread>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include "../basic/Point2d.hpp"
 #include "../preds/Predicates.hpp"
+#include "node_arena.hpp"
+#include "thread_group.hpp"
 
 
 class CH2d_dlclist{
@@ -29,69 +44,1065 @@ class CH2d_dlclist{
 		Node* back;
 		Node* front;
 	};
+	// the CH2d_array uses the same algorithms of construction
+	friend class CH2d_array;
+	// the ConvexLayers has the layers in clockwise order already
+	friend class CompGeomLibrary;
 private:
 	Node* head;
 	Node* tail;
 	unsigned int my_size;
 	double my_area;
+	
+	// the chain indexes are in the lexicographic order of Point2d.hpp
+	typedef std::map<Point2d,Node*,lexicographic_comp> chain_index;
+	
+	bool my_indexed;        // true if the push uses the chain indexes, see set_indexed_push
+	chain_index my_upper;   // the nodes of the upper hull, from the head to the last point lexicographically
+	chain_index my_lower;   // the nodes of the lower hull, from the head to the last point lexicographically
+	Point2d my_origin;      // the origin of the cross products of my_area_sum
+	double my_area_sum;     // the sum of the cross products of the edges, it is -2 times the area
+	double my_perimeter;    // the sum of the lengths of the edges
+	double my_cx_sum;       // the sum of (x1+x2)*cross of the edges, with respect to my_origin
+	double my_cy_sum;       // the sum of (y1+y2)*cross of the edges, with respect to my_origin
+	node_arena my_own_arena; // the arena of the nodes if the user didn't give one
+	node_arena* my_arena;    // the arena of the nodes, my_own_arena or the arena of the user
+
+	// the first guess of the size of the convex hull(2d) at the Chan's algorithm, the next 
+	// guesses are its square, its fourth power and so on
+	static const int CHAN_FIRST_GUESS = 32;
+
+	/**
+	 * The lexicographic order of the points, it is the lexicographic_comp of Point2d.hpp.
+	 * Purpose : It is the order that the Andrew's algorithm (monotone chain) needs, the first 
+	 * point of this order is the head of the convex hull(2d).
+	 * @param p1 the fir. point
+	 * @param p2 the sec. point
+	 * @returns true if p1 is before p2 at the lexicographic order
+	 */
+	static bool lexicographic_less(const Point2d& p1, const Point2d& p2)
+	{
+		return lexicographic_comp()(p1,p2);
+	}
+
+	/**
+	 * The Andrew's algorithm (monotone chain) for points that are already sorted.
+	 * Purpose : It builds the upper hull from the left to the right and then the lower hull 
+	 * from the right to the left, so the result is in clockwise order and it starts from the
+	 * head. The time complexity is O(n) because there is no sorting.
+	 * @param sorted the points sorted by lexicographic_less, without duplicates
+	 * @returns the vertices of the convex hull(2d) in clockwise order starting from the point 
+	 * with the minimum x and the minimum y. The collinear points are not vertices.
+	 */
+	static std::vector<Point2d> monotone_chain_sorted(const std::vector<Point2d>& sorted)
+	{
+		int siz = sorted.size();
+		if( siz < 3 )
+		{
+			return sorted;
+		}
+		std::vector<Point2d> ch_points(2*siz);
+		int k = 0;
+		//upper hull iteration, while the last three do not make a clockwise turn delete the middle
+		for( int i = 0; i < siz; i++ )
+		{
+			while( k >= 2 && Predicates::getSignedOrientation(ch_points[k-2],ch_points[k-1],sorted[i]) <= 0 )
+			{
+				k--;
+			}
+			ch_points[k++] = sorted[i];
+		}
+		//lower hull iteration, the last point of the upper hull is the first of the lower hull
+		int upp_siz = k+1;
+		for( int i = siz-2; i >= 0; i-- )
+		{
+			while( k >= upp_siz && Predicates::getSignedOrientation(ch_points[k-2],ch_points[k-1],sorted[i]) <= 0 )
+			{
+				k--;
+			}
+			ch_points[k++] = sorted[i];
+		}
+		//the last point is the head again
+		ch_points.resize(k-1);
+		return ch_points;
+	}
+
+	/**
+	 * The Andrew's algorithm (monotone chain), O(n*log(n)) because of the sorting.
+	 * @param points the set of points of which we will build the convex hull(2d)
+	 * @returns the vertices of the convex hull(2d) in clockwise order starting from the head
+	 */
+	static std::vector<Point2d> monotone_chain(std::vector<Point2d> points)
+	{
+		std::sort(points.begin(),points.end(),lexicographic_less);
+		points.erase(std::unique(points.begin(),points.end()),points.end());
+		return monotone_chain_sorted(points);
+	}
+
+	/**
+	 * It finds the tangent from the point "p" to an upper hull, it is used by the chan function.
+	 * Purpose : The upper hull is concave, so the orientation of "p" with the consecutive vertices 
+	 * that are lexicographically after "p" is non negative up to the tangent and negative after it. 
+	 * Thus we find the tangent with a binary search, in O(log(size of the upper hull)).
+	 * @param upp contains the vertices of the upper hull at the positions from "first" to "last"-1,
+	 * sorted by lexicographic_less
+	 * @param first the position of the first vertex of the upper hull
+	 * @param last the position after the last vertex of the upper hull
+	 * @param p a point that lies on or above the upper hull
+	 * @returns the position of the vertex of the upper hull that is after "p" lexicographically 
+	 * and makes the greatest slope with "p" (the most distant if there are collinear), or -1 if 
+	 * there is no vertex after "p"
+	 */
+	static int upper_tangent(const std::vector<Point2d>& upp, int first, int last, const Point2d& p)
+	{
+		int low = std::upper_bound(upp.begin()+first,upp.begin()+last,p,lexicographic_less) - upp.begin();
+		int high = last-1;
+		if( low > high )
+		{
+			return -1;
+		}
+		while( low < high )
+		{
+			int mid = (low+high)/2;
+			if( Predicates::getSignedOrientation(upp[mid],p,upp[mid+1]) >= 0 )
+			{
+				//the next vertex is at the left of the ray from p to the mid, or further on it
+				low = mid+1;
+			}else
+			{
+				high = mid;
+			}
+		}
+		return low;
+	}
+	
+	/**
+	 * It wraps the upper hull of the groups from "first" to "last" as the Jarvis march does, but
+	 * it finds the candidate of every group with the upper_tangent.
+	 * @param upp_groups the upper hulls of the groups one after the other, every one sorted by 
+	 * lexicographic_less
+	 * @param offsets the upper hull of the group g is at the positions from offsets[g] to offsets[g+1]-1
+	 * @param first the point with the minimum x and the minimum y of all groups
+	 * @param last the point with the maximum x and the maximum y of all groups
+	 * @param max_steps the maximum number of the vertices we are allowed to find 
+	 * @param upp at the end contains the vertices of the upper hull from "first" to "last"
+	 * @returns false if the upper hull has more than max_steps vertices
+	 */
+	static bool wrap_upper_hull(const std::vector<Point2d>& upp_groups, const std::vector<int>& offsets,
+	                            const Point2d& first, const Point2d& last, int max_steps, std::vector<Point2d>& upp)
+	{
+		upp.clear();
+		upp.push_back(first);
+		int groups_siz = offsets.size()-1;
+		while( !(upp.back() == last) )
+		{
+			if( (int)upp.size() > max_steps )
+			{
+				return false;
+			}
+			Point2d p = upp.back();
+			int best = -1;
+			for( int g = 0; g < groups_siz; g++ )
+			{
+				int cand = upper_tangent(upp_groups,offsets[g],offsets[g+1],p);
+				if( cand < 0 )
+				{
+					continue;
+				}
+				if( best < 0 )
+				{
+					best = cand;
+				}else
+				{
+					double orient = Predicates::getSignedOrientation(upp_groups[best],p,upp_groups[cand]);
+					if( orient > 0 || (orient == 0 && lexicographic_less(upp_groups[best],upp_groups[cand])) )
+					{
+						//the candidate has greater slope or it is collinear and more distant
+						best = cand;
+					}
+				}
+			}
+			upp.push_back(upp_groups[best]);
+		}
+		return true;
+	}
+	
+	/**
+	 * It keeps the convex hull(2d) of every group of the chan function. The vertices of the group g
+	 * are at the positions from offsets[g] to offsets[g+1]-1 of the "sorted" sorted by 
+	 * lexicographic_less, so the groups of the next guess are made by merging, and the upper hulls
+	 * and the lower hulls (as the upper hulls of the opposite points) of the groups are appended to
+	 * the upp_groups and the low_groups for the wrap_upper_hull.
+	 * @param group the points of a group sorted by lexicographic_less, without duplicates
+	 */
+	static void add_chan_group(const std::vector<Point2d>& group, std::vector<Point2d>& sorted, std::vector<int>& offsets,
+	                           std::vector<Point2d>& upp_groups, std::vector<int>& upp_offsets,
+	                           std::vector<Point2d>& low_groups, std::vector<int>& low_offsets)
+	{
+		std::vector<Point2d> group_ch = monotone_chain_sorted(group);
+		int group_ch_siz = group_ch.size();
+		//the upper hull of the group is from the head to the last point lexicographically,
+		//the lower hull is from that point to the head
+		int pos_last = std::max_element(group_ch.begin(),group_ch.end(),lexicographic_less) - group_ch.begin();
+		for( int i = 0; i < group_ch_siz; i++ )
+		{
+			if( i <= pos_last )
+			{
+				upp_groups.push_back(group_ch[i]);
+			}
+			if( i >= pos_last )
+			{
+				low_groups.push_back(-group_ch[i]);
+			}
+		}
+		if( pos_last != 0 )
+		{
+			low_groups.push_back(-group_ch[0]);
+		}
+		upp_offsets.push_back(upp_groups.size());
+		low_offsets.push_back(low_groups.size());
+		std::vector<Point2d> group_sorted = sorted_vertices(group_ch);
+		sorted.insert(sorted.end(),group_sorted.begin(),group_sorted.end());
+		offsets.push_back(sorted.size());
+	}
+
+	/**
+	 * The Chan's algorithm, O(n*log(h)) where h is the size of the convex hull(2d).
+	 * Purpose : For every guess m of the size of the convex hull(2d) it splits the points into 
+	 * groups of m points, it builds the convex hull(2d) of every group and then it wraps the upper 
+	 * hull and the lower hull as the Jarvis march with at most m steps. The lower hull is wrapped as
+	 * the upper hull of the opposite points. A point that is not a vertex of the convex hull(2d) of 
+	 * its group is not a vertex of the convex hull(2d) at all, so the next guess m*m keeps only the 
+	 * convex hulls of the groups and it makes every new group by merging the sorted vertices of m
+	 * groups, without sorting again. The points pass first from the akl_toussaint_filter and the 
+	 * first guess is CHAN_FIRST_GUESS, so for few vertices the work is one pass for the filter and 
+	 * the sorting of small groups of the survivors.
+	 * @param points the set of points of which we will build the convex hull(2d)
+	 * @returns the vertices of the convex hull(2d) in clockwise order starting from the head
+	 */
+	static std::vector<Point2d> chan(const std::vector<Point2d>& points)
+	{
+		unsigned int discarded;
+		std::vector<Point2d> work = akl_toussaint_filter(points,discarded);
+		int work_siz = work.size();
+		if( work_siz < 3 )
+		{
+			return monotone_chain(work);
+		}
+		//the head and the last point lexicographically are vertices, they survive the filter
+		Point2d first = work[0];
+		Point2d last = work[0];
+		for( int i = 1; i < work_siz; i++ )
+		{
+			if( lexicographic_less(work[i],first) ) first = work[i];
+			if( lexicographic_less(last,work[i]) ) last = work[i];
+		}
+		if( first == last )
+		{
+			return std::vector<Point2d>(1,first);
+		}
+		
+		std::vector<Point2d> sorted;
+		std::vector<int> offsets(1,0);
+		std::vector<Point2d> upp_groups;
+		std::vector<Point2d> low_groups;
+		std::vector<int> upp_offsets(1,0);
+		std::vector<int> low_offsets(1,0);
+		std::vector<Point2d> upp;
+		std::vector<Point2d> low;
+		//the first guess, the groups of m points are sorted
+		//the constant is copied, std::min takes references and it has no definition out of the class
+		int m = CHAN_FIRST_GUESS;
+		m = std::min(m,work_siz);
+		for( int start = 0; start < work_siz; start += m )
+		{
+			std::vector<Point2d> group(work.begin()+start,work.begin()+std::min(start+m,work_siz));
+			std::sort(group.begin(),group.end(),lexicographic_less);
+			group.erase(std::unique(group.begin(),group.end()),group.end());
+			add_chan_group(group,sorted,offsets,upp_groups,upp_offsets,low_groups,low_offsets);
+		}
+		std::vector<Point2d>().swap(work);
+		while( !wrap_upper_hull(upp_groups,upp_offsets,first,last,m,upp) ||
+		       !wrap_upper_hull(low_groups,low_offsets,-last,-first,m,low) )
+		{
+			//the next guess m*m, a new group is m groups of the previous guess (all of them if the 
+			//guess exceeds the number of the points) and it is made by merging their sorted vertices
+			int per_group = ( (long long)m*m < work_siz ) ? m : (int)offsets.size()-1;
+			m = ( (long long)m*m < work_siz ) ? m*m : work_siz;
+			std::vector<Point2d> prev_sorted;
+			std::vector<int> prev_offsets(1,0);
+			prev_sorted.swap(sorted);
+			prev_offsets.swap(offsets);
+			upp_groups.clear();
+			low_groups.clear();
+			upp_offsets.assign(1,0);
+			low_offsets.assign(1,0);
+			int prev_groups = prev_offsets.size()-1;
+			for( int g = 0; g < prev_groups; g += per_group )
+			{
+				int stop = std::min(g+per_group,prev_groups);
+				std::vector<Point2d> group(prev_sorted.begin()+prev_offsets[g],prev_sorted.begin()+prev_offsets[stop]);
+				//bottom up merging of the sorted groups, the width doubles at every round
+				for( int width = 1; width < stop-g; width *= 2 )
+				{
+					for( int i = g; i+width < stop; i += 2*width )
+					{
+						int mid = prev_offsets[i+width] - prev_offsets[g];
+						int end = prev_offsets[std::min(i+2*width,stop)] - prev_offsets[g];
+						std::inplace_merge(group.begin()+(prev_offsets[i]-prev_offsets[g]),group.begin()+mid,
+						                   group.begin()+end,lexicographic_less);
+					}
+				}
+				group.erase(std::unique(group.begin(),group.end()),group.end());
+				add_chan_group(group,sorted,offsets,upp_groups,upp_offsets,low_groups,low_offsets);
+			}
+		}
+		//the upper hull and then the lower hull without the first and the last
+		std::vector<Point2d> ch_points(upp);
+		for( int i = 1; i < (int)low.size()-1; i++ )
+		{
+			ch_points.push_back(-low[i]);
+		}
+		return ch_points;
+	}
+
+	/**
+	 * @param ch_points the vertices of a convex hull(2d) in clockwise order starting from the head
+	 * @returns the same vertices sorted by lexicographic_less, in O(size of the convex hull) 
+	 * because the upper hull and the lower hull are already sorted.
+	 */
+	static std::vector<Point2d> sorted_vertices(const std::vector<Point2d>& ch_points)
+	{
+		int siz = ch_points.size();
+		int pos_last = std::max_element(ch_points.begin(),ch_points.end(),lexicographic_less) - ch_points.begin();
+		std::vector<Point2d> sorted;
+		sorted.reserve(siz);
+		//the upper hull goes forward from the head and the lower hull backwards from the head
+		int upp = 0;
+		int low = siz-1;
+		while( upp <= pos_last || low > pos_last )
+		{
+			if( low <= pos_last || (upp <= pos_last && lexicographic_less(ch_points[upp],ch_points[low])) )
+			{
+				sorted.push_back(ch_points[upp++]);
+			}else
+			{
+				sorted.push_back(ch_points[low--]);
+			}
+		}
+		return sorted;
+	}
+	
+	/**
+	 * It merges two convex hulls(2d) in O(h1+h2), where h1 and h2 are their sizes.
+	 * Purpose : The vertices of the two convex hulls are merged in lexicographic order as
+	 * the merge sort does and the monotone_chain_sorted makes the upper hull and the lower 
+	 * hull of them. 
+	 * @param ch_points_1 the vertices of the fir. convex hull(2d) in clockwise order starting from the head
+	 * @param ch_points_2 the vertices of the sec. convex hull(2d) in clockwise order starting from the head
+	 * @returns the vertices of the convex hull(2d) of both in clockwise order starting from the head
+	 */
+	static std::vector<Point2d> merge_hulls(const std::vector<Point2d>& ch_points_1, const std::vector<Point2d>& ch_points_2)
+	{
+		if( ch_points_1.empty() )
+		{
+			return ch_points_2;
+		}else if( ch_points_2.empty() )
+		{
+			return ch_points_1;
+		}
+		std::vector<Point2d> sorted_1 = sorted_vertices(ch_points_1);
+		std::vector<Point2d> sorted_2 = sorted_vertices(ch_points_2);
+		std::vector<Point2d> sorted(sorted_1.size()+sorted_2.size());
+		std::merge(sorted_1.begin(),sorted_1.end(),sorted_2.begin(),sorted_2.end(),sorted.begin(),lexicographic_less);
+		sorted.erase(std::unique(sorted.begin(),sorted.end()),sorted.end());
+		return monotone_chain_sorted(sorted);
+	}
+	
+	/**
+	 * It is the work of one thread of the parallel_hull, the monotone_chain of a part of the points.
+	 * @param points the set of points
+	 * @param start the position of the first point of the part 
+	 * @param stop the position after the last point of the part
+	 * @param ch_points at the end contains the vertices of the convex hull(2d) of the part
+	 */
+	static void hull_of_part(const std::vector<Point2d>* points, int start, int stop, std::vector<Point2d>* ch_points)
+	{
+		*ch_points = monotone_chain(std::vector<Point2d>(points->begin()+start,points->begin()+stop));
+	}
+	
+	/**
+	 * It is the work of one thread of the parallel_hull, the merge of two convex hulls(2d).
+	 * @param ch_points_1 the vertices of the fir. convex hull(2d)
+	 * @param ch_points_2 the vertices of the sec. convex hull(2d)
+	 * @param ch_points at the end contains the vertices of the merged convex hull(2d)
+	 */
+	static void merge_part(const std::vector<Point2d>* ch_points_1, const std::vector<Point2d>* ch_points_2, 
+	                       std::vector<Point2d>* ch_points)
+	{
+		*ch_points = merge_hulls(*ch_points_1,*ch_points_2);
+	}
+	
+	/**
+	 * The divide and conquer construction with threads.
+	 * Purpose : It splits the points into one part for every thread, every thread builds the
+	 * convex hull(2d) of its part with the monotone_chain and then the convex hulls are merged
+	 * in pairs, every merge in its own thread, until there is one convex hull(2d).
+	 * @param points the set of points of which we will build the convex hull(2d)
+	 * @param num_threads the number of the threads, if it is 0 we use as many threads as the 
+	 * hardware supports
+	 * @returns the vertices of the convex hull(2d) in clockwise order starting from the head
+	 */
+	static std::vector<Point2d> parallel_hull(const std::vector<Point2d>& points, unsigned int num_threads)
+	{
+		if( num_threads == 0 )
+		{
+			num_threads = std::max(1u,std::thread::hardware_concurrency());
+		}
+		int size_of_vec = points.size();
+		int num_parts = std::max(1,std::min((int)num_threads,size_of_vec));
+		std::vector< std::vector<Point2d> > parts(num_parts);
+		//the group joins its threads before an exception leaves this function and it throws the
+		//exceptions of the threads here, so a std::bad_alloc reaches the caller as in "Andrew"
+		thread_group threads;
+		for( int i = 0; i < num_parts; i++ )
+		{
+			int start = (long long)size_of_vec*i/num_parts;
+			int stop = (long long)size_of_vec*(i+1)/num_parts;
+			threads.run(std::bind(hull_of_part,&points,start,stop,&parts[i]));
+		}
+		threads.join();
+		
+		//the pairwise merges, at every round the number of the convex hulls is halved
+		while( parts.size() > 1 )
+		{
+			int parts_siz = parts.size();
+			std::vector< std::vector<Point2d> > merged((parts_siz+1)/2);
+			for( int i = 0; i+1 < parts_siz; i += 2 )
+			{
+				threads.run(std::bind(merge_part,&parts[i],&parts[i+1],&merged[i/2]));
+			}
+			if( parts_siz%2 == 1 )
+			{
+				merged.back().swap(parts.back());
+			}
+			threads.join();
+			parts.swap(merged);
+		}
+		return parts[0];
+	}
+
+	/**
+	 * It calculates the getSignedOrientation(b,a,p) for a block of points p, i.e the same 
+	 * determinant with the same operations, which is positive if p is at the left of the
+	 * line from a to b. 
+	 * Purpose : It is the partitioning step of the quickhull, with AVX2 it calculates 4 
+	 * determinants at once.
+	 * @param a_x x coordinate of the point a
+	 * @param a_y y coordinate of the point a
+	 * @param b_x x coordinate of the point b
+	 * @param b_y y coordinate of the point b
+	 * @param xs the x coordinates of the points of the block
+	 * @param ys the y coordinates of the points of the block
+	 * @param count the number of the points of the block
+	 * @param res at the end contains the determinants, res[i] for the point (xs[i],ys[i])
+	 */
+	static void signed_orientations(double a_x, double a_y, double b_x, double b_y, const double* xs, const double* ys,
+	                                int count, double* res)
+	{
+		double d_x = b_x - a_x;
+		double d_y = b_y - a_y;
+		int i = 0;
+#if defined(__AVX2__)
+		__m256d v_a_x = _mm256_set1_pd(a_x);
+		__m256d v_a_y = _mm256_set1_pd(a_y);
+		__m256d v_d_x = _mm256_set1_pd(d_x);
+		__m256d v_d_y = _mm256_set1_pd(d_y);
+		for( ; i+4 <= count; i += 4 )
+		{
+			__m256d p_x = _mm256_loadu_pd(xs+i);
+			__m256d p_y = _mm256_loadu_pd(ys+i);
+			__m256d left = _mm256_mul_pd(v_d_x,_mm256_sub_pd(p_y,v_a_y));
+			__m256d right = _mm256_mul_pd(v_d_y,_mm256_sub_pd(p_x,v_a_x));
+			_mm256_storeu_pd(res+i,_mm256_sub_pd(left,right));
+		}
+#endif
+		for( ; i < count; i++ )
+		{
+			res[i] = d_x*(ys[i] - a_y) - d_y*(xs[i] - a_x);
+		}
+	}
+	
+	/**
+	 * It moves the points with positive left_res at the start of the range, the points with
+	 * positive right_res at the end of the range and the rest between them, like the Dutch 
+	 * national flag problem. A point can't have both positive.
+	 * @param xs the x coordinates of the points
+	 * @param ys the y coordinates of the points
+	 * @param left_res the determinants of the points for the left part 
+	 * @param right_res the determinants of the points for the right part
+	 * @param lo the position of the first point of the range
+	 * @param hi the position after the last point of the range
+	 * @param left_end at the end is the position after the last point of the left part 
+	 * @param right_start at the end is the position of the first point of the right part
+	 */
+	static void partition_three_ways(std::vector<double>& xs, std::vector<double>& ys, std::vector<double>& left_res,
+	                                 std::vector<double>& right_res, int lo, int hi, int& left_end, int& right_start)
+	{
+		int i = lo;
+		left_end = lo;
+		right_start = hi;
+		while( i < right_start )
+		{
+			int j = -1;
+			if( left_res[i] > 0 )
+			{
+				j = left_end++;
+			}else if( right_res[i] > 0 )
+			{
+				j = --right_start;
+			}
+			if( j >= 0 && j != i )
+			{
+				std::swap(xs[i],xs[j]);
+				std::swap(ys[i],ys[j]);
+				std::swap(left_res[i],left_res[j]);
+				std::swap(right_res[i],right_res[j]);
+			}
+			if( j < 0 || j < i || (j == i && left_res[i] > 0) )
+			{
+				//the point at i is checked, otherwise at i came an unchecked point from the end
+				i++;
+			}
+		}
+	}
+	
+	/**
+	 * A part of the work of the quickhull, it is either to find the vertices between the a and b 
+	 * from the points at the positions from lo to hi-1, or to add the vertex a to the convex hull(2d).
+	 */
+	struct quickhull_task{
+		Point2d a;
+		Point2d b;
+		int lo;
+		int hi;
+		bool add_vertex;
+	};
+	
+	/**
+	 * The quickhull, O(n*log(n)) on average and O(n^2) at the worst case.
+	 * Purpose : It finds the point with the minimum x (and minimum y) and the point with the
+	 * maximum x (and maximum y), the points at the left of the line between them are the 
+	 * upper hull candidates and the points at the right are the lower hull candidates. Then 
+	 * for every set of candidates of a line ab it finds the most distant point c, the points 
+	 * at the left of ac and the points at the left of cb are the candidates of the next lines 
+	 * and all the others are thrown away. The determinants of the partitioning are calculated 
+	 * by the signed_orientations. 
+	 * We use a stack of tasks instead of recursion because the depth maybe O(n).
+	 * @param points the set of points of which we will build the convex hull(2d)
+	 * @returns the vertices of the convex hull(2d) in clockwise order starting from the head
+	 */
+	static std::vector<Point2d> quickhull(const std::vector<Point2d>& points)
+	{
+		int size_of_vec = points.size();
+		if( size_of_vec < 3 )
+		{
+			return monotone_chain(points);
+		}
+		Point2d first = points[0];
+		Point2d last = points[0];
+		std::vector<double> xs(size_of_vec);
+		std::vector<double> ys(size_of_vec);
+		for( int i = 0; i < size_of_vec; i++ )
+		{
+			xs[i] = points[i].GetX();
+			ys[i] = points[i].GetY();
+			if( lexicographic_less(points[i],first) ) first = points[i];
+			if( lexicographic_less(last,points[i]) ) last = points[i];
+		}
+		std::vector<Point2d> ch_points(1,first);
+		if( first == last )
+		{
+			return ch_points;
+		}
+		std::vector<double> left_res(size_of_vec);
+		std::vector<double> right_res(size_of_vec);
+		signed_orientations(first.GetX(),first.GetY(),last.GetX(),last.GetY(),&xs[0],&ys[0],size_of_vec,&left_res[0]);
+		signed_orientations(last.GetX(),last.GetY(),first.GetX(),first.GetY(),&xs[0],&ys[0],size_of_vec,&right_res[0]);
+		int left_end, right_start;
+		partition_three_ways(xs,ys,left_res,right_res,0,size_of_vec,left_end,right_start);
+		
+		//the tasks are done in the reverse order of their insertion
+		std::vector<quickhull_task> tasks;
+		quickhull_task task;
+		task.add_vertex = false;
+		task.a = last;
+		task.b = first;
+		task.lo = right_start;
+		task.hi = size_of_vec;
+		tasks.push_back(task);
+		task.add_vertex = true;
+		task.a = last;
+		tasks.push_back(task);
+		task.add_vertex = false;
+		task.a = first;
+		task.b = last;
+		task.lo = 0;
+		task.hi = left_end;
+		tasks.push_back(task);
+		while( !tasks.empty() )
+		{
+			task = tasks.back();
+			tasks.pop_back();
+			if( task.add_vertex )
+			{
+				ch_points.push_back(task.a);
+				continue;
+			}
+			int count = task.hi - task.lo;
+			if( count == 0 )
+			{
+				continue;
+			}
+			//the most distant point from the line ab, if there are many we take the one that is 
+			//more far along the line, otherwise the middle of three collinear points would be a vertex
+			double a_x = task.a.GetX();
+			double a_y = task.a.GetY();
+			double d_x = task.b.GetX() - a_x;
+			double d_y = task.b.GetY() - a_y;
+			signed_orientations(a_x,a_y,task.b.GetX(),task.b.GetY(),&xs[task.lo],&ys[task.lo],count,&left_res[task.lo]);
+			int pos_c = task.lo;
+			for( int i = task.lo+1; i < task.hi; i++ )
+			{
+				if( left_res[i] > left_res[pos_c] || ( left_res[i] == left_res[pos_c] && 
+				    d_x*(xs[i]-a_x) + d_y*(ys[i]-a_y) > d_x*(xs[pos_c]-a_x) + d_y*(ys[pos_c]-a_y) ) )
+				{
+					pos_c = i;
+				}
+			}
+			Point2d c(xs[pos_c],ys[pos_c]);
+			signed_orientations(a_x,a_y,c.GetX(),c.GetY(),&xs[task.lo],&ys[task.lo],count,&left_res[task.lo]);
+			signed_orientations(c.GetX(),c.GetY(),task.b.GetX(),task.b.GetY(),&xs[task.lo],&ys[task.lo],count,&right_res[task.lo]);
+			partition_three_ways(xs,ys,left_res,right_res,task.lo,task.hi,left_end,right_start);
+			
+			quickhull_task sub_task;
+			sub_task.add_vertex = false;
+			sub_task.a = c;
+			sub_task.b = task.b;
+			sub_task.lo = right_start;
+			sub_task.hi = task.hi;
+			tasks.push_back(sub_task);
+			sub_task.add_vertex = true;
+			tasks.push_back(sub_task);
+			sub_task.add_vertex = false;
+			sub_task.a = task.a;
+			sub_task.b = c;
+			sub_task.lo = task.lo;
+			sub_task.hi = left_end;
+			tasks.push_back(sub_task);
+		}
+		return ch_points;
+	}
+
+	/**
+	 * It makes the dlc list from the vertices of a convex hull(2d), "this" list must be empty.
+	 * Purpose : Every algorithm that produces the vertices in a vector uses this function 
+	 * to make the list, to find the tail and to set the size.
+	 * @param ch_points the vertices of the convex hull(2d) in clockwise order starting from 
+	 * the point with the minimum x and the minimum y.
+	 */
+	void link_clockwise(const std::vector<Point2d>& ch_points)
+	{
+		int siz = ch_points.size();
+		head = 0;
+		tail = 0;
+		my_size = 0;
+		if( siz == 0 )
+		{
+			return;
+		}
+		my_arena->reserve(siz,sizeof(Node));
+		head = new_node();
+		head->data = ch_points[0];
+		tail = head;
+		Node* last_node = head;
+		for( int i = 1; i < siz; i++ )
+		{
+			Node* tmp = new_node();
+			tmp->data = ch_points[i];
+			last_node->front = tmp;
+			tmp->back = last_node;
+			last_node = tmp;
+			//the tail is the point with the maximum x and the minimum y, with two points 
+			//the tail is the point that is not the head as the other constructors do.
+			if( siz == 2 || ch_points[i].GetX() > tail->data.GetX() || 
+			    (ch_points[i].GetX() == tail->data.GetX() && ch_points[i].GetY() < tail->data.GetY()) )
+			{
+				tail = tmp;
+			}
+		}
+		last_node->front = head;
+		head->back = last_node;
+		my_size = siz;
+	}
+
+	/**
+	 * @returns the vertices of the list in clockwise order starting from the head, in O(size of
+	 * the convex hull)
+	 */
+	std::vector<Point2d> clockwise_points() const
+	{
+		std::vector<Point2d> ch_points;
+		ch_points.reserve(my_size);
+		if( my_size > 0 )
+		{
+			Node* curr = head;
+			do
+			{
+				ch_points.push_back(curr->data);
+				curr = curr->front;
+			}while( curr != head );
+		}
+		return ch_points;
+	}
 
 	/**
-	 * calculate the area of a triangle.
-	 * Purpose :  It is an auxilliary function to be used in the function notify_area.
-	 * Maybe it should be in another class as a static class.
-	 * @param p1 A point of the triangle
-	 * @param p2 A point of the triangle
-	 * @param p3 A point of the triangle 
-	 * @returns The area of the triangle consistute of the 3 points
+	 * It makes the list from vertices that are already a convex hull(2d), in O(size of the convex hull)
+	 * without sorting them, see link_clockwise.
+	 * @param ch_points the vertices of the convex hull(2d) in clockwise order starting from the point
+	 * with the minimum x and the minimum y, without collinear vertices
+	 * @returns the list, it is not indexed
+	 */
+	static CH2d_dlclist from_clockwise(const std::vector<Point2d>& ch_points)
+	{
+		CH2d_dlclist res;
+		res.link_clockwise(ch_points);
+		res.recalculate_sums();
+		res.notify_area();
+		return res;
+	}
+
+	/**
+	 * @returns the cross product of the edge from p1 to p2 with respect to my_origin, the sum 
+	 * of them for all the edges of the list is -2 times the area of the convex hull(2d)
+	 */
+	double edge_cross(const Point2d& p1, const Point2d& p2) const
+	{
+		return (p1.GetX() - my_origin.GetX())*(p2.GetY() - my_origin.GetY()) - 
+		       (p1.GetY() - my_origin.GetY())*(p2.GetX() - my_origin.GetX());
+	}
+	
+	/**
+	 * It adds (sign = 1) or removes (sign = -1) the edge from p1 to p2 to the sums of the area, 
+	 * the perimeter and the centroid, so every change of the list updates them in O(1) per 
+	 * changed edge.
+	 */
+	void account_edge(const Point2d& p1, const Point2d& p2, int sign)
+	{
+		double cross = edge_cross(p1,p2);
+		my_area_sum += sign*cross;
+		my_perimeter += sign*Point2d::Distanceof2dPoints(p1,p2);
+		my_cx_sum += sign*(p1.GetX() + p2.GetX() - 2*my_origin.GetX())*cross;
+		my_cy_sum += sign*(p1.GetY() + p2.GetY() - 2*my_origin.GetY())*cross;
+	}
+	
+	/**
+	 * It accounts the insertion (sign = 1) or the removal (sign = -1) of the vertex "mid" between
+	 * the consecutive vertices "bef" and "aft", in clockwise order.
+	 */
+	void account_vertex(const Point2d& bef, const Point2d& mid, const Point2d& aft, int sign)
+	{
+		account_edge(bef,aft,-sign);
+		account_edge(bef,mid,sign);
+		account_edge(mid,aft,sign);
+	}
+	
+	/**
+	 * It calculates the sums of the area, the perimeter and the centroid from all the edges, 
+	 * in O(size of convex hull). It is used when the list is made from the beginning.
+	 */
+	void recalculate_sums()
+	{
+		my_area_sum = 0;
+		my_perimeter = 0;
+		my_cx_sum = 0;
+		my_cy_sum = 0;
+		if( my_size == 0 )
+		{
+			return;
+		}
+		my_origin = head->data;
+		Node* curr = head;
+		do
+		{
+			account_edge(curr->data,curr->front->data,1);
+			curr = curr->front;
+		}while( curr != head );
+	}
+	
+	/**
+	 * It copies the sums of the area, the perimeter and the centroid of the other list.
+	 */
+	void copy_sums(const CH2d_dlclist& other_ch)
+	{
+		my_origin = other_ch.my_origin;
+		my_area_sum = other_ch.my_area_sum;
+		my_perimeter = other_ch.my_perimeter;
+		my_cx_sum = other_ch.my_cx_sum;
+		my_cy_sum = other_ch.my_cy_sum;
+	}
+	
+	/**
+	 * It links two consecutive nodes of a chain index and it adds their edge to my_area_sum.
+	 * At the upper hull the node after "bef" is "aft", at the lower hull the node after "aft" is "bef". 
+	 * @param bef the node that is before lexicographically
+	 * @param aft the node that is after lexicographically
+	 * @param upper true for the upper hull, false for the lower hull
+	 */
+	void link_in_chain(Node* bef, Node* aft, bool upper)
+	{
+		if( upper )
+		{
+			bef->front = aft;
+			aft->back = bef;
+			account_edge(bef->data,aft->data,1);
+		}else
+		{
+			aft->front = bef;
+			bef->back = aft;
+			account_edge(aft->data,bef->data,1);
+		}
+	}
+	
+	/**
+	 * It removes the edge of two consecutive nodes of a chain index from my_area_sum, the 
+	 * links are changed later by the link_in_chain.
+	 * @param bef the node that is before lexicographically
+	 * @param aft the node that is after lexicographically
+	 * @param upper true for the upper hull, false for the lower hull
+	 */
+	void unlink_in_chain(const Node* bef, const Node* aft, bool upper)
+	{
+		if( upper )
+		{
+			account_edge(bef->data,aft->data,-1);
+		}else
+		{
+			account_edge(aft->data,bef->data,-1);
+		}
+	}
+	
+	/**
+	 * It inserts the query node to a chain index if its point is outside of the chain and it removes 
+	 * the vertices of the chain which are not vertices any more, in O(log(h)) amortized because every 
+	 * removed vertex was inserted once. 
+	 * @param chain the upper hull or the lower hull
+	 * @param upper true if the chain is the upper hull, false if it is the lower hull
+	 * @param query_nod the node of the query point, its point must not be a vertex of the chain
+	 * @param removed at the end the removed nodes are added to this vector
+	 * @returns true if the query point became a vertex of the chain
+	 */
+	bool insert_in_chain(chain_index& chain, bool upper, Node* query_nod, std::vector<Node*>& removed)
+	{
+		const Point2d& query_po = query_nod->data;
+		//at the upper hull the vertices make clockwise turns from the left to the right, at the 
+		//lower hull counter clockwise turns
+		double sign = upper ? 1 : -1;
+		chain_index::iterator aft = chain.lower_bound(query_po);
+		if( aft != chain.begin() && aft != chain.end() )
+		{
+			chain_index::iterator bef = aft;
+			--bef;
+			if( sign*Predicates::getSignedOrientation(bef->first,query_po,aft->first) <= 0 )
+			{
+				//the query point is under the upper hull or above the lower hull
+				return false;
+			}
+			unlink_in_chain(bef->second,aft->second,upper);
+		}
+		chain_index::iterator query_it = chain.insert(aft,std::make_pair(query_po,query_nod));
+		
+		//the vertices after the query point that don't make the right turn are removed
+		aft = query_it;
+		++aft;
+		while( aft != chain.end() )
+		{
+			chain_index::iterator aft_aft = aft;
+			++aft_aft;
+			if( aft_aft == chain.end() || sign*Predicates::getSignedOrientation(query_po,aft->first,aft_aft->first) > 0 )
+			{
+				break;
+			}
+			unlink_in_chain(aft->second,aft_aft->second,upper);
+			removed.push_back(aft->second);
+			chain.erase(aft);
+			aft = aft_aft;
+		}
+		
+		//the same for the vertices before the query point
+		chain_index::iterator bef = query_it;
+		while( bef != chain.begin() )
+		{
+			--bef;
+			if( bef == chain.begin() )
+			{
+				break;
+			}
+			chain_index::iterator bef_bef = bef;
+			--bef_bef;
+			if( sign*Predicates::getSignedOrientation(bef_bef->first,bef->first,query_po) > 0 )
+			{
+				break;
+			}
+			unlink_in_chain(bef_bef->second,bef->second,upper);
+			removed.push_back(bef->second);
+			chain.erase(bef);
+			bef = query_it;
+		}
+		
+		if( query_it != chain.begin() )
+		{
+			bef = query_it;
+			--bef;
+			link_in_chain(bef->second,query_nod,upper);
+		}
+		aft = query_it;
+		++aft;
+		if( aft != chain.end() )
+		{
+			link_in_chain(query_nod,aft->second,upper);
+		}
+		return true;
+	}
+	
+	/**
+	 * The push when the list is indexed, O(log(h)) amortized where h is the size of the convex hull(2d). 
+	 * @param query_po Is the point that maybe added to the list.
+	 * @returns -1 if the point wasn't added to the list, 1 if the point was added to the list.
 	 */
-	double area_of_triangle(const Point2d& p1, const Point2d& p2, const Point2d& p3)
+	int push_indexed(const Point2d& query_po)
 	{
-		double A_x = p1.GetX();
-		double A_y = p1.GetY();
-		double B_x = p2.GetX();
-		double B_y = p2.GetY();
-		double C_x = p3.GetX();
-		double C_y = p3.GetY();
-		return std::abs( (A_x*(B_y-C_y) + B_x*(C_y-A_y) + C_x*(A_y-B_y))/2.0 );
+		if( my_upper.count(query_po) > 0 || my_lower.count(query_po) > 0 )
+		{
+			return -1;
+		}
+		Node* query_nod = new_node();
+		query_nod->data = query_po;
+		if( my_size == 0 )
+		{
+			query_nod->front = query_nod;
+			query_nod->back = query_nod;
+			my_upper[query_po] = query_nod;
+			my_lower[query_po] = query_nod;
+			head = query_nod;
+			my_size = 1;
+			recalculate_sums();
+		}else
+		{
+			std::vector<Node*> removed;
+			bool in_upper = insert_in_chain(my_upper,true,query_nod,removed);
+			bool in_lower = insert_in_chain(my_lower,false,query_nod,removed);
+			if( !in_upper && !in_lower )
+			{
+				delete_node(query_nod);
+				return -1;
+			}
+			//a node is deleted if it is not in any chain, the head and the last may be removed
+			//from both chains
+			std::sort(removed.begin(),removed.end());
+			removed.erase(std::unique(removed.begin(),removed.end()),removed.end());
+			for( int i = 0; i < (int)removed.size(); i++ )
+			{
+				chain_index::iterator upp_it = my_upper.find(removed[i]->data);
+				chain_index::iterator low_it = my_lower.find(removed[i]->data);
+				if( (upp_it == my_upper.end() || upp_it->second != removed[i]) &&
+				    (low_it == my_lower.end() || low_it->second != removed[i]) )
+				{
+					delete_node(removed[i]);
+				}
+			}
+		}
+		notify_indexed();
+		return 1;
 	}
-
+	
 	/**
-	 * This method notify the area of the convex hull.
-	 * Purpose : This method was made because of the time complexity of the notification of 
-	 * the area which is O(size of convex hull), thus maybe in future edition we change it 
-	 * in public in order to give to the user of this class to decide whether or not to notify 
-	 * the area. In this way the user of this class can handle whether or not to pay this 
-	 * linear time to notify the area.
+	 * It sets the head, the tail, the size and the area from the chain indexes, in O(log(h)).
 	 */
-	void notify_area()
+	void notify_indexed()
 	{
-		if( my_size == 0 || my_size == 1 || my_size == 2 ){
-			my_area = 0;
-		}else 
+		head = my_upper.begin()->second;
+		Node* last = my_upper.rbegin()->second;
+		my_size = my_upper.size() + my_lower.size() - 2;
+		if( my_upper.size() == 1 )
 		{
-			//in order to find the area of the convex hull we will divide it 
-			//into triangles 
-			
-			// the below three iterators point to different nodes because
-			// there are at least three nodes in the list
-			CH2d_dlclist::ch_iterator it_clo_back = ch_iterator(head);
-			CH2d_dlclist::ch_iterator it_clo_front = it_clo_back + 1;
-			CH2d_dlclist::ch_iterator it_cou_clo = it_clo_back-1;
-			
-			// at the below variable we will keep the sum of the areas of 
-			//every triangle
-			double sum = 0;
-			sum += area_of_triangle(*it_clo_back,*it_clo_front,*it_cou_clo);
-			
-			while( ++it_clo_front != it_cou_clo )
+			my_size = 1;
+		}
+		//the tail is the last point lexicographically or the one below it
+		tail = last;
+		if( my_size > 2 )
+		{
+			chain_index::reverse_iterator below = my_lower.rbegin();
+			++below;
+			if( below->first.GetX() == last->data.GetX() )
 			{
-				it_clo_back++;
-				sum += area_of_triangle(*it_clo_back,*it_clo_front,*it_cou_clo);
-			}	
-			my_area = sum;
+				tail = below->second;
+			}
 		}
-		
-		
+		notify_area();
+	}
+	
+	/**
+	 * @returns a new node from the arena
+	 */
+	Node* new_node()
+	{
+		return new (my_arena->allocate(sizeof(Node))) Node;
+	}
+	
+	/**
+	 * It gives back a node to the arena.
+	 */
+	void delete_node(Node* nod)
+	{
+		nod->~Node();
+		my_arena->deallocate(nod,sizeof(Node));
+	}
+	
+	/**
+	 * It deletes all the nodes of the list, the head and the tail are not valid after it.
+	 */
+	void delete_nodes()
+	{
+		if (head != 0)
+		{
+			Node* curr;
+			Node* last;
+			curr = head;
+			last = head->back;
+			while( curr != last )
+			{
+				Node* tmp = curr;
+				curr = curr->front;
+				//you should uncomment the below if you are running tests
+				//std::cout << "deletion : " << tmp->data <<  ", with address : " << tmp << "\n";
+				delete_node(tmp);
+			}
+			//you should uncomment the below if you are running tests
+			//std::cout << "deletion : " << last->data << ", with address : " << last << "\n"; 
+			delete_node(last);
+		}
+	}
+	
+	/**
+	 * This method notify the area of the convex hull.
+	 * Purpose : The area was calculated again from all the triangles after every push, in
+	 * O(size of convex hull). Now every change of the list updates the sums of the edges 
+	 * (see account_edge) for the edges that changed, and the area is read from them in O(1).
+	 */
+	void notify_area()
+	{
+		my_area = ( my_size < 3 ) ? 0 : std::abs(my_area_sum)/2.0;
 	}
 public:
 	class ch_iterator{
@@ -142,14 +1153,21 @@ public:
 
 	/**
 	 *   Default Constructor
-	 * 
+	 *   @param arena the arena of the nodes, if it is 0 the list uses its own arena. The arena
+	 *   must live more than the list.
 	 */
-	CH2d_dlclist() 
+	explicit CH2d_dlclist(node_arena* arena = 0) 
 	{
+		my_arena = (arena != 0) ? arena : &my_own_arena;
 		head = 0;
 		tail = 0;
 		my_size = 0;
 		my_area = 0;
+		my_indexed = false;
+		my_area_sum = 0;
+		my_perimeter = 0;
+		my_cx_sum = 0;
+		my_cy_sum = 0;
 	}
 	
 	
@@ -157,27 +1175,36 @@ public:
 	 * Copy Constructor
 	 *
 	 * @returns other_ch is the Convexhull2d that we make a copy of this.
+	 * The copy uses the same arena as the other_ch if it is an arena of the user, 
+	 * otherwise it uses its own arena.
 	 */
 	CH2d_dlclist(const CH2d_dlclist& other_ch)
 	{
+		my_arena = (other_ch.my_arena != &other_ch.my_own_arena) ? other_ch.my_arena : &my_own_arena;
 		if(other_ch.my_size > 0)
 		{
+			my_arena->reserve(other_ch.my_size,sizeof(Node));
 			CH2d_dlclist::ch_iterator curr_it(other_ch.begin());
-			Node* curr = new Node;
+			Node* curr = new_node();
 			curr->data = *curr_it;
 			head = curr;
+			tail = head;
 			Node* pre_curr = curr;
 			while(++curr_it != other_ch.head)
 			{
-				curr = new Node;
+				curr = new_node();
 				curr->data = *curr_it;
 				pre_curr->front = curr;
 				curr->back = pre_curr;
 				pre_curr = curr;
+				if( curr_it == other_ch.end() )
+				{
+					//the tail must point to the node of this list
+					tail = curr;
+				}
 			}
 			curr->front = head;
 			head->back = curr;
-			tail = other_ch.tail;
 			
 			my_size = other_ch.my_size;
 			my_area = other_ch.my_area;
@@ -188,20 +1215,149 @@ public:
 			my_size = 0;
 			my_area = 0;
 		}
+		copy_sums(other_ch);
+		set_indexed_push(other_ch.my_indexed);
 	}
 	
 	
 		
+	/**
+	 * The Akl-Toussaint heuristic. It finds the extreme points in the directions of x, y, x+y and x-y
+	 * and it throws away every point that lies strictly inside the octagon of these extreme points,
+	 * because such a point can't be a vertex of the convex hull(2d). 
+	 * Purpose : It is a filter of O(n) that we can run before any algorithm of the construction,
+	 * for uniformly distributed points it throws away the most of them.
+	 * @param points the set of points that will be filtered
+	 * @param discarded at the end contains the number of the points that were thrown away
+	 * @returns the points that survived, in the order that they were at the "points"
+	 */
+	static std::vector<Point2d> akl_toussaint_filter(const std::vector<Point2d>& points, unsigned int& discarded)
+	{
+		discarded = 0;
+		int size_of_vec = points.size();
+		if( size_of_vec < 3 )
+		{
+			return points;
+		}
+		//the positions of the extreme points in clockwise order, starting from the one with
+		//the minimum x : min x, max y-x, max y, max x+y, max x, max x-y, min y, min x+y
+		//and their values in these directions
+		int ext[8] = {0,0,0,0,0,0,0,0};
+		double x_0 = points[0].GetX();
+		double y_0 = points[0].GetY();
+		double val[8] = {x_0,y_0-x_0,y_0,x_0+y_0,x_0,x_0-y_0,y_0,x_0+y_0};
+		for( int i = 1; i < size_of_vec; i++ )
+		{
+			double x = points[i].GetX();
+			double y = points[i].GetY();
+			if( x < val[0] ) {ext[0] = i; val[0] = x;}
+			if( y-x > val[1] ) {ext[1] = i; val[1] = y-x;}
+			if( y > val[2] ) {ext[2] = i; val[2] = y;}
+			if( x+y > val[3] ) {ext[3] = i; val[3] = x+y;}
+			if( x > val[4] ) {ext[4] = i; val[4] = x;}
+			if( x-y > val[5] ) {ext[5] = i; val[5] = x-y;}
+			if( y < val[6] ) {ext[6] = i; val[6] = y;}
+			if( x+y < val[7] ) {ext[7] = i; val[7] = x+y;}
+		}
+		//the octagon may have less than 8 different vertices
+		std::vector<Point2d> octagon;
+		for( int j = 0; j < 8; j++ )
+		{
+			if( octagon.empty() || !(octagon.back() == points[ext[j]]) )
+			{
+				octagon.push_back(points[ext[j]]);
+			}
+		}
+		while( octagon.size() > 1 && octagon.back() == octagon.front() )
+		{
+			octagon.pop_back();
+		}
+		int oct_siz = octagon.size();
+		if( oct_siz < 3 )
+		{
+			return points;
+		}
+		
+		//the rectangle between the diagonal extreme points, if its corners are in the octagon every 
+		//point strictly inside it is strictly inside the octagon and it is thrown away with four
+		//comparisons instead of the orientations with the edges
+		double rect_xmin = std::max(points[ext[1]].GetX(),points[ext[7]].GetX());
+		double rect_xmax = std::min(points[ext[3]].GetX(),points[ext[5]].GetX());
+		double rect_ymin = std::max(points[ext[5]].GetY(),points[ext[7]].GetY());
+		double rect_ymax = std::min(points[ext[1]].GetY(),points[ext[3]].GetY());
+		bool rect_inside = rect_xmin < rect_xmax && rect_ymin < rect_ymax;
+		for( int c = 0; c < 4 && rect_inside; c++ )
+		{
+			Point2d corner((c < 2) ? rect_xmin : rect_xmax,(c%2 == 0) ? rect_ymin : rect_ymax);
+			for( int j = 0; j < oct_siz && rect_inside; j++ )
+			{
+				rect_inside = Predicates::getSignedOrientation(octagon[(j+1)%oct_siz],octagon[j],corner) <= 0;
+			}
+		}
+		
+		std::vector<Point2d> survivors;
+		for( int i = 0; i < size_of_vec; i++ )
+		{
+			double x = points[i].GetX();
+			double y = points[i].GetY();
+			if( rect_inside && rect_xmin < x && x < rect_xmax && rect_ymin < y && y < rect_ymax )
+			{
+				continue;
+			}
+			//the octagon is in clockwise order so the interior is at the right of every edge
+			bool inside = true;
+			for( int j = 0; j < oct_siz && inside; j++ )
+			{
+				inside = Predicates::getSignedOrientation(octagon[(j+1)%oct_siz],octagon[j],points[i]) < 0;
+			}
+			if( !inside )
+			{
+				survivors.push_back(points[i]);
+			}
+		}
+		discarded = size_of_vec - survivors.size();
+		return survivors;
+	}
+	
+	
 	/**
 	 * 
 	 * Purpose : To implement basic algorithm or algorithms for the creation of a convex hull 
 	 * in the plane(2d).
-	 * @param points The set of points of which we will build the convex hull(2d)
-	 * @param algorithm The algorithm we will use to construct the convex hull(2d) 
+	 * @param all_points The set of points of which we will build the convex hull(2d)
+	 * @param algorithm The algorithm we will use to construct the convex hull(2d) :
+	 * "Jarvis" for the Jarvis march, O(n*h) where h is the size of the convex hull(2d),
+	 * "Andrew" for the Andrew's algorithm (monotone chain), O(n*log(n)),
+	 * "Chan" for the Chan's algorithm, O(n*log(h)),
+	 * "Parallel" for the divide and conquer with threads, every thread runs the Andrew's algorithm 
+	 * for a part of the points and then the convex hulls of the parts are merged in linear time,
+	 * "Quickhull" for the quickhull, O(n*log(n)) on average,
+	 * "Auto" chooses the Andrew's algorithm, it is as fast as the Jarvis march for few points and
+	 * it handles the duplicate points, the Jarvis march doesn't.
+	 * @param prefilter if it is true the points pass from the akl_toussaint_filter before 
+	 * the algorithm runs
+	 * @param num_threads the number of the threads of the "Parallel" algorithm, if it is 0 
+	 * we use as many threads as the hardware supports
+	 * @param arena the arena of the nodes, if it is 0 the list uses its own arena. The arena
+	 * must live more than the list.
+	 * @throws std::invalid_argument if the algorithm is unknown
 	 * 
 	 */
-	CH2d_dlclist(const std::vector<Point2d>& points, std::string algorithm = "Jarvis")
+	CH2d_dlclist(const std::vector<Point2d>& all_points, std::string algorithm = "Auto", bool prefilter = false,
+	             unsigned int num_threads = 0, node_arena* arena = 0)
 	{
+		my_arena = (arena != 0) ? arena : &my_own_arena;
+		std::vector<Point2d> survivors;
+		if( prefilter )
+		{
+			unsigned int discarded;
+			survivors = akl_toussaint_filter(all_points,discarded);
+		}
+		//the algorithms run on the "points" which are the survivors if we have filtered
+		const std::vector<Point2d>& points = prefilter ? survivors : all_points;
+		my_indexed = false;
+		my_area_sum = 0;
+		
 		int size_of_vec = points.size();
 		if( size_of_vec == 0 )
 		{
@@ -211,7 +1367,7 @@ public:
 			my_area = 0;
 		}else if( size_of_vec == 1 )
 		{
-			head = new Node;
+			head = new_node();
 			head->data = points[0];
 			head->front = head;
 			head->back = head;
@@ -222,7 +1378,7 @@ public:
 		{
 			if( points[0] == points[1] )
 			{
-				head = new Node;
+				head = new_node();
 				head->data = points[0];
 				head->front = head;
 				head->back = head;
@@ -231,8 +1387,8 @@ public:
 				my_area = 0;
 			}else if( points[0].GetX() == points[1].GetX() )
 			{
-				head = new Node;
-				tail = new Node;
+				head = new_node();
+				tail = new_node();
 				if( points[0].GetY() < points[1].GetY() )
 				{
 					head->data = points[0];
@@ -251,8 +1407,8 @@ public:
 				my_area = 0;
 			}else 
 			{
-				head = new Node;
-				tail = new Node;
+				head = new_node();
+				tail = new_node();
 				if( points[0].GetX() < points[1].GetX() )
 				{
 					head->data = points[0];
@@ -271,6 +1427,11 @@ public:
 			}
 		}else
 		{
+			if( algorithm.compare("Auto") == 0 )
+			{
+				algorithm = "Andrew";
+			}
+			
 			if( algorithm.compare("Jarvis") == 0 )
 			{
 				//firstly we have to find the point with the minimum x  i.e the one we get from
@@ -295,7 +1456,7 @@ public:
 				// the first point of the convex hull(2d).We have also the position of the tail for sure the
 				//"points[pos_tail]" wil be, certainly, a point of the convex hull(2d).
 				
-				head = new Node;
+				head = new_node();
 				head->data = points[pos_head];
 				my_size =1;
 				Node* last_node = head;//we have to hold also the last node added to the list
@@ -333,7 +1494,7 @@ public:
 					if( pos_next_cand != pos_head )
 					{
 						//below we insert the point to the dlc list
-						Node* tmp = new Node;
+						Node* tmp = new_node();
 						tmp->data = points[pos_next_cand];
 						last_node->front = tmp;
 						tmp->back = last_node;
@@ -354,9 +1515,25 @@ public:
 						head->back = last_node;
 					}
 				}
+			}else if( algorithm.compare("Andrew") == 0 )
+			{
+				link_clockwise(monotone_chain(points));
+			}else if( algorithm.compare("Chan") == 0 )
+			{
+				link_clockwise(chan(points));
+			}else if( algorithm.compare("Parallel") == 0 )
+			{
+				link_clockwise(parallel_hull(points,num_threads));
+			}else if( algorithm.compare("Quickhull") == 0 )
+			{
+				link_clockwise(quickhull(points));
+			}else
+			{
+				throw std::invalid_argument( "Unknown algorithm for the construction of the CH2d_dlclist : " + algorithm );
 			}
-			notify_area();
 		}
+		recalculate_sums();
+		notify_area();
 	};
 
 	
@@ -367,23 +1544,11 @@ public:
 	 */
 	~CH2d_dlclist()
 	{
-		if (head != 0)
+		//the own arena gives back its slabs at once, the nodes go back one by one only to 
+		//the arena of the user
+		if( my_arena != &my_own_arena )
 		{
-			Node* curr;
-			Node* last;
-			curr = head;
-			last = head->back;
-			while( curr != last )
-			{
-				Node* tmp = curr;
-				curr = curr->front;
-				//you should uncomment the below if you are running tests
-				//std::cout << "deletion : " << tmp->data <<  ", with address : " << tmp << "\n";
-				delete tmp;
-			}
-			//you should uncomment the below if you are running tests
-			//std::cout << "deletion : " << last->data << ", with address : " << last << "\n"; 
-			delete last;
+			delete_nodes();
 		}
 	}
 	
@@ -398,23 +1563,10 @@ public:
 		if (this != &other_ch)
 		{
 			//firstly we have to delete the list that "this" holds, otherwise we
-			//will have a memory leak 
-			if ( head!= 0 ) 
-			{
-				Node* curr;
-				Node* last;
-				curr = head;
-				last = head->back;
-				while( curr->front != last )
-				{
-					Node* tmp = curr;
-					curr = curr->front;
-					//std::cout << "Deletion of the node with address : " << tmp << "\n";
-					delete tmp;
-				}
-				//std::cout << "Deletion of the node with address : " << last << "\n";
-				delete last;
-			}
+			//will have a memory leak. The nodes go back to the arena and the copy
+			//takes them again
+			delete_nodes();
+			my_arena->reserve(other_ch.my_size,sizeof(Node));
 			//the above was the last command of the deletion of "this" list.
 				
 			if( other_ch.my_size > 0 )
@@ -422,22 +1574,27 @@ public:
 			//we are iterating the "other_ch" through the iterator we made for safety, we don't want 
 			//to handle directly the list from pointers to Node. Even if the "other_ch" is const 
 				CH2d_dlclist::ch_iterator curr_it(other_ch.begin());
-				Node* curr = new Node;
+				Node* curr = new_node();
 				curr->data = *curr_it;
 				head = curr;
+				tail = head;
 				Node* pre_curr = curr;
 				while(++curr_it != other_ch.head)
 				{
-					curr = new Node;
+					curr = new_node();
 					curr->data = *curr_it;
 					pre_curr->front = curr;
 					curr->back = pre_curr;
 					pre_curr = curr;
+					if( curr_it == other_ch.end() )
+					{
+						//the tail must point to the node of this list
+						tail = curr;
+					}
 				}
 				curr->front = head;
 				head->back = curr;
 
-				tail = other_ch.tail;
 				my_size = other_ch.my_size;
 				my_area = other_ch.my_area;
 			}else
@@ -447,10 +1604,74 @@ public:
 				my_size = 0;
 				my_area = 0;
 			}
+			copy_sums(other_ch);
+			set_indexed_push(other_ch.my_indexed);
+		}
+		return *this;
+	}
+	
+	/**
+	 * Move Constructor, it takes the nodes of the other_ch in O(1), the other_ch becomes empty.
+	 * @param other_ch the CH2d_dlclist of which the nodes are taken
+	 */
+	CH2d_dlclist(CH2d_dlclist&& other_ch) noexcept
+	{
+		my_arena = &my_own_arena;
+		head = 0;
+		tail = 0;
+		my_size = 0;
+		my_area = 0;
+		my_indexed = false;
+		my_area_sum = 0;
+		my_perimeter = 0;
+		my_cx_sum = 0;
+		my_cy_sum = 0;
+		swap(other_ch);
+	}
+	
+	/**
+	 * Move Assignment Operator, it takes the nodes of the other_ch in O(1) and the other_ch 
+	 * takes the nodes of "this" and frees them. "this" uses the arena of the other_ch after it.
+	 * @param other_ch the CH2d_dlclist of which the nodes are taken
+	 * @returns a reference of "this"
+	 */
+	CH2d_dlclist& operator=(CH2d_dlclist&& other_ch) noexcept
+	{
+		if( this != &other_ch )
+		{
+			CH2d_dlclist tmp(std::move(other_ch));
+			swap(tmp);
 		}
 		return *this;
 	}
 	
+	/**
+	 * It swaps two lists in O(1), the nodes are not copied. Every list keeps the arena of its
+	 * nodes, the own arenas are swapped with the nodes.
+	 * @param other_ch the other CH2d_dlclist
+	 */
+	void swap(CH2d_dlclist& other_ch) noexcept
+	{
+		bool own = (my_arena == &my_own_arena);
+		bool other_own = (other_ch.my_arena == &other_ch.my_own_arena);
+		node_arena* arena = my_arena;
+		my_own_arena.swap(other_ch.my_own_arena);
+		my_arena = other_own ? &my_own_arena : other_ch.my_arena;
+		other_ch.my_arena = own ? &other_ch.my_own_arena : arena;
+		std::swap(head,other_ch.head);
+		std::swap(tail,other_ch.tail);
+		std::swap(my_size,other_ch.my_size);
+		std::swap(my_area,other_ch.my_area);
+		std::swap(my_indexed,other_ch.my_indexed);
+		my_upper.swap(other_ch.my_upper);
+		my_lower.swap(other_ch.my_lower);
+		std::swap(my_origin,other_ch.my_origin);
+		std::swap(my_area_sum,other_ch.my_area_sum);
+		std::swap(my_perimeter,other_ch.my_perimeter);
+		std::swap(my_cx_sum,other_ch.my_cx_sum);
+		std::swap(my_cy_sum,other_ch.my_cy_sum);
+	}
+	
 
 	
 	/**
@@ -459,6 +1680,7 @@ public:
 	* the addition of the point to a list, if the list size is >= 3, is
 	* O(n). Because it runs the upper hull and the lower hull to check 
 	* if there are not anti clockwise turns in the convex hull(2d). 
+	* If the list is indexed (see set_indexed_push) the complexity is O(log(n)) amortized.
 	* Purpose : to add a point if it is not interval to the convex hull(2d) 
 	* @param query_po Is the point that maybe added to the list.
 	* @returns -1 if the point wasn't added to the list, 1 if the point
@@ -466,15 +1688,20 @@ public:
 	*/
 	int push(const Point2d& query_po) 
 	{
+		if( my_indexed )
+		{
+			return push_indexed(query_po);
+		}
 		if( my_size == 0 )
 		{
-			head = new Node;
+			head = new_node();
 			head->data = query_po;
 			head->front = head;
 			head->back = head;
 			tail = head;
 			my_size ++ ;
-			my_area = 0;
+			recalculate_sums();
+			notify_area();
 			return 1;
 		}else if( my_size == 1 )
 		{
@@ -484,7 +1711,7 @@ public:
 			//the current point of the list is represented by the head
 			if( !(query_po == current_nod->data) )//if the points are not equal
 			{
-				Node* new_elem = new Node; // if we construct the new point Node and it will not be added we will have 
+				Node* new_elem = new_node(); // if we construct the new point Node and it will not be added we will have 
 				// a memory leak, so I declare and initialize the node inside the if
 				new_elem->data = query_po;
 					
@@ -515,7 +1742,8 @@ public:
 				tail->back = head;
 				tail->front = head;
 				my_size++;
-				my_area = 0;
+				recalculate_sums();
+				notify_area();
 				return 1; 
 			}else
 			{
@@ -539,7 +1767,7 @@ public:
 			}else if( Predicates::getSignedOrientation(query_po,head->data,tail->data) == 0 ) 
 			{
 				// the new element is collinear but it will be added to the list
-				Node* new_elem = new Node;
+				Node* new_elem = new_node();
 				new_elem->data = query_po;
 				if( head->data.GetX() == tail->data.GetX() )
 				{
@@ -548,26 +1776,26 @@ public:
 					if( query_po.GetY() < head->data.GetY() )
 					{
 						// the new element must substitute the head and the (old) head must be deleted
-						delete head;//the old head must be deleted 
+						delete_node(head);//the old head must be deleted 
 						head = new_elem;
 					}else
 					{
 						//std::cout << "(DEBUGGING) : deleting " << tail->data  << "\n";
 						// the new element must substitute the tail and the (old) head must be deleted
-						delete tail;// the old tail must be deleted
+						delete_node(tail);// the old tail must be deleted
 						tail = new_elem;
 					}
 				}else if( query_po.GetX() < head->data.GetX() )
 				{
 					//std::cout << "(DEBUGGING) : deleting " << head->data  << "\n";
 					// the new element must substitute the head and the (old) head must be deleted
-					delete head;//the old head must be deleted 
+					delete_node(head);//the old head must be deleted 
 					head = new_elem;
 				}else
 				{
 					//std::cout << "(DEBUGGING) : deleting " << tail->data  << "\n";
 					// the new element must substitute the tail and the (old) head must be deleted
-					delete tail;// the old tail must be deleted
+					delete_node(tail);// the old tail must be deleted
 					tail = new_elem;
 				}
 				head->front = tail;
@@ -575,12 +1803,13 @@ public:
 				tail->front = head;
 				head->back = tail;
 				//becareful we added a new element but we deleted also so there is no change in
-				//the size, nor change to the area because is zero again;
+				//the size, nor change to the area because is zero again, but the perimeter changed
+				recalculate_sums();
 				return 1;
 			}else 
 			{
 				// in this case the query point has a "random" position and it will be added to the list
-				Node* new_elem = new Node;
+				Node* new_elem = new_node();
 				new_elem->data = query_po;
 				if( query_po.GetX() < head->data.GetX() ||
 				    (query_po.GetX() == head->data.GetX() && query_po.GetY() < head->data.GetY()) )
@@ -661,6 +1890,7 @@ public:
 					
 				}
 				my_size++;
+				recalculate_sums();
 				notify_area();
 				return 1;
 			}			
@@ -671,7 +1901,7 @@ public:
 			//reason is you can't know how many points front or back you have to delete
 			//if the query point will be added to the list.
 			
-			Node* query_nod = new Node;//it is helpfull to create the node of the query point
+			Node* query_nod = new_node();//it is helpfull to create the node of the query point
 			query_nod->data = query_po;//because it is very helpfull in the deletion later.
 			
 			bool quer_po_added = false;// it is very usefull to see if the query point added
@@ -696,12 +1926,14 @@ public:
 					new_head->back = bef;
 					new_head->front = head;
 					head->back = new_head;
+					account_vertex(bef->data,new_head->data,head->data,1);
 				}else
 				{
 					head->front = new_head;
 					new_head->back = head;
 					new_head->front = aft;
 					aft->back = new_head;
+					account_vertex(head->data,new_head->data,aft->data,1);
 				}
 				
 				quer_po_added = true;
@@ -724,12 +1956,14 @@ public:
 					new_tail->back = bef;
 					new_tail->front = tail;
 					tail->back = new_tail;
+					account_vertex(bef->data,new_tail->data,tail->data,1);
 				}else
 				{
 					tail->front = new_tail;
 					new_tail->back = tail;
 					new_tail->front = aft;
 					aft->back = new_tail;					
+					account_vertex(tail->data,new_tail->data,aft->data,1);
 				}
 					
 				quer_po_added = true;
@@ -749,7 +1983,7 @@ public:
 					{
 						// this is the case where the query point is equal to one point of the 
 						// current convex hull
-						delete query_nod;//we must delete the query point that we allocated
+						delete_node(query_nod);//we must delete the query point that we allocated
 						return -1;
 					}
 					if( prev->data.GetX() != after->data.GetX() && 
@@ -767,6 +2001,7 @@ public:
 							query_nod->back = prev;
 							query_nod->front = after;
 							after->back = query_nod;
+							account_vertex(prev->data,query_po,after->data,1);
 							quer_po_added = true;
 							my_size++;//the size must be increased. at the later stage may also be decreased.
 							break;//if we find the position of the query point in the list then we must stop
@@ -784,7 +2019,7 @@ public:
 					{
 						// this is the case where the query point is equal to one point of the 
 						// current convex hull
-						delete query_nod;//we must delete the query point that we allocated
+						delete_node(query_nod);//we must delete the query point that we allocated
 						return -1;
 					}
 					if( prev->data.GetX() != after->data.GetX() && 
@@ -799,6 +2034,7 @@ public:
 							query_nod->back = prev;
 							query_nod->front = after;
 							after->back = query_nod;
+							account_vertex(prev->data,query_po,after->data,1);
 							quer_po_added = true;
 							my_size++;//the size must be increased. at the later stage may also be decreased.
 							break;//if we find the position of the query point in the list the we must stop
@@ -814,7 +2050,7 @@ public:
 			{
 				//if the query point have not been added to the list then we don't have 
 				//to proceed any further because there is no change in the list. 
-				delete query_nod;
+				delete_node(query_nod);
 				return -1;
 			}
 				
@@ -841,6 +2077,7 @@ public:
 					//std::cout << "(DEBUGGING) : " << upp[siz-3]->data << " " << upp[siz-2]->data << " " << upp[siz-1]->data << "\n";
 					upp[siz-3]->front = upp[siz-1];
 					upp[siz-1]->back = upp[siz-3];
+					account_vertex(upp[siz-3]->data,upp[siz-2]->data,upp[siz-1]->data,-1);
 					del.push(upp[siz-2]);
 					upp.erase(upp.end()-2);
 					siz = upp.size();
@@ -864,6 +2101,7 @@ public:
 					//std::cout << "(DEBUGGING) : " << low[siz-3]->data << " " << low[siz-2]->data << " " << low[siz-1]->data << "\n";
 					low[siz-3]->front = low[siz-1];
 					low[siz-1]->back = low[siz-3];
+					account_vertex(low[siz-3]->data,low[siz-2]->data,low[siz-1]->data,-1);
 					del.push(low[siz-2]);
 					low.erase(low.end()-2);
 					siz = low.size();
@@ -887,7 +2125,7 @@ public:
 					//std::cout << "(DEBUGGING) : deleting " << del.top()->data  << "\n";
 				}
 				//DEBUGGING code ends
-				delete del.top();
+				delete_node(del.top());
 				del.pop();
 				my_size--;
 			}
@@ -905,6 +2143,176 @@ public:
 	}
 	
 	
+	/**
+	 * It pushes a batch of points at once. The convex hull(2d) of the batch is made by the
+	 * monotone chain and it is merged with the list in one pass, so the complexity is 
+	 * O(h + k*log(k)) where h is the size of the list and k the size of the batch, instead of 
+	 * O(h*k) of k pushes. The area is calculated once at the end. The nodes of the list are
+	 * made again, so the iterators of the list are not valid after the push_batch. 
+	 * If the list is indexed the indexes are made again in O(h*log(h)).
+	 * Purpose : to add points that come in batches of many thousands.
+	 * @param batch the points that maybe added to the list
+	 * @returns the number of the points of the batch that became vertices of the convex hull(2d),
+	 * a point that is many times in the batch is counted once
+	 */
+	int push_batch(const std::vector<Point2d>& batch)
+	{
+		if( batch.empty() )
+		{
+			return 0;
+		}
+		std::vector<Point2d> old_points = clockwise_points();
+		std::vector<Point2d> ch_points = merge_hulls(old_points,monotone_chain(batch));
+		//the new vertices are the vertices that were not in the list, we find them comparing
+		//the sorted vertices as the merge sort does
+		int added = 0;
+		std::vector<Point2d> sorted_old = old_points.empty() ? old_points : sorted_vertices(old_points);
+		std::vector<Point2d> sorted_new = sorted_vertices(ch_points);
+		int pos_old = 0;
+		for( int i = 0; i < (int)sorted_new.size(); i++ )
+		{
+			while( pos_old < (int)sorted_old.size() && lexicographic_less(sorted_old[pos_old],sorted_new[i]) )
+			{
+				pos_old++;
+			}
+			if( pos_old == (int)sorted_old.size() || !(sorted_old[pos_old] == sorted_new[i]) )
+			{
+				added++;
+			}
+		}
+		if( added == 0 )
+		{
+			return 0;
+		}
+		bool indexed = my_indexed;
+		delete_nodes();
+		link_clockwise(ch_points);
+		recalculate_sums();
+		notify_area();
+		set_indexed_push(indexed);
+		return added;
+	}
+	
+	/**
+	 * It pushes the points of a range as a batch, see push_batch(const std::vector<Point2d>&).
+	 * @param first the first point of the range
+	 * @param last the position after the last point of the range
+	 * @returns the number of the points of the range that became vertices of the convex hull(2d)
+	 */
+	template <class InputIterator>
+	int push_batch(InputIterator first, InputIterator last)
+	{
+		return push_batch(std::vector<Point2d>(first,last));
+	}
+
+	/**
+	 * It makes the convex hull(2d) of the vertices of two convex hulls in O(h1+h2), where h1 and h2
+	 * are their sizes. The upper hulls and the lower hulls of the two are already sorted, so they
+	 * are merged in lexicographic order and the monotone chain passes over them once, no point is
+	 * sorted again. 
+	 * Purpose : To make one convex hull(2d) from the convex hulls of many parts of the points.
+	 * @param ch_1 the first convex hull(2d)
+	 * @param ch_2 the second convex hull(2d)
+	 * @param arena the arena of the nodes of the result, if it is 0 the result uses its own arena
+	 * @returns the convex hull(2d) of the vertices of both, it is not indexed
+	 */
+	static CH2d_dlclist merge(const CH2d_dlclist& ch_1, const CH2d_dlclist& ch_2, node_arena* arena = 0)
+	{
+		CH2d_dlclist res(arena);
+		res.link_clockwise(merge_hulls(ch_1.clockwise_points(),ch_2.clockwise_points()));
+		res.recalculate_sums();
+		res.notify_area();
+		return res;
+	}
+
+	/**
+	 * It makes the list the convex hull(2d) of its vertices and of the vertices of an other convex
+	 * hull(2d), in O(h1+h2), see merge. If the list is indexed the indexes are made again in
+	 * O(h*log(h)). The nodes of the list are made again, so the iterators of the list are not valid
+	 * after it, unless nothing changes.
+	 * @param other_ch the other convex hull(2d), it may be the list itself
+	 * @returns true if the list changed
+	 */
+	bool merge_from(const CH2d_dlclist& other_ch)
+	{
+		if( other_ch.my_size == 0 || &other_ch == this )
+		{
+			return false;
+		}
+		std::vector<Point2d> old_points = clockwise_points();
+		std::vector<Point2d> ch_points = merge_hulls(old_points,other_ch.clockwise_points());
+		//the list is the same if the vertices are the same, the convex hulls have the same head
+		//and the same clockwise order
+		if( ch_points == old_points )
+		{
+			return false;
+		}
+		bool indexed = my_indexed;
+		delete_nodes();
+		link_clockwise(ch_points);
+		recalculate_sums();
+		notify_area();
+		set_indexed_push(indexed);
+		return true;
+	}
+	
+	
+	/**
+	 * It changes the way that the push works. When the list is indexed the upper hull and the
+	 * lower hull are kept also in balanced search trees and the push finds the position of the
+	 * point, checks if it is interior and removes the vertices that are not vertices any more 
+	 * in O(log(h)) amortized, where h is the size of the convex hull(2d). It also updates the area 
+	 * from the edges that were changed. The iteration of the list doesn't change.
+	 * Purpose : For a stream of points the push is O(h) when the list is not indexed.
+	 * @param indexed true to index the list in O(h*log(h)), false to remove the indexes
+	 */
+	void set_indexed_push(bool indexed)
+	{
+		my_upper.clear();
+		my_lower.clear();
+		my_indexed = indexed;
+		if( !indexed || my_size == 0 )
+		{
+			return;
+		}
+		//the upper hull is from the head forward to the last point lexicographically and 
+		//the lower hull from the head backwards to the same point
+		Node* last = head;
+		Node* curr = head;
+		do
+		{
+			if( lexicographic_less(last->data,curr->data) )
+			{
+				last = curr;
+			}
+			curr = curr->front;
+		}while( curr != head );
+		curr = head;
+		my_upper[curr->data] = curr;
+		while( curr != last )
+		{
+			curr = curr->front;
+			my_upper[curr->data] = curr;
+		}
+		curr = head;
+		my_lower[curr->data] = curr;
+		while( curr != last )
+		{
+			curr = curr->back;
+			my_lower[curr->data] = curr;
+		}
+	}
+	
+	
+	/**
+	 * @returns true if the push uses the chain indexes, see set_indexed_push
+	 */
+	bool is_indexed_push() const
+	{
+		return my_indexed;
+	}
+	
+	
 	/**
 	 * @returns the number of the points consistute the convex hull
 	 */
@@ -941,7 +2349,41 @@ public:
 		return my_area;
 	}
 	
+	/**
+	 * @returns the perimeter of the convex hull(2d), it is updated with the edges that change
+	 * in every push. For two vertices it is twice their distance, as the list goes and returns.
+	 */
+	double perimeter() const
+	{
+		return my_perimeter;
+	}
+	
+	/**
+	 * @returns the centroid of the area of the convex hull(2d), it is updated with the edges that
+	 * change in every push. For one vertex it is the vertex and for two vertices their middle.
+	 */
+	Point2d centroid() const
+	{
+		assert( my_size > 0 );
+		if( my_size == 1 )
+		{
+			return head->data;
+		}else if( my_size == 2 )
+		{
+			return Point2d((head->data.GetX() + tail->data.GetX())/2.0,(head->data.GetY() + tail->data.GetY())/2.0);
+		}
+		return Point2d(my_origin.GetX() + my_cx_sum/(3*my_area_sum),my_origin.GetY() + my_cy_sum/(3*my_area_sum));
+	}
+	
 };
 
+/**
+ * It swaps two lists in O(1), see CH2d_dlclist::swap.
+ */
+inline void swap(CH2d_dlclist& ch_1, CH2d_dlclist& ch_2) noexcept
+{
+	ch_1.swap(ch_2);
+}
+
 
 #endif
\ No newline at end of file
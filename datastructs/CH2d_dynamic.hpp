@@ -0,0 +1,924 @@
+/**
+    Purpose: To represent the convex hull of a set of 2d points that changes, the points can be inserted
+    and erased. The CH2d_dlclist can only grow, here if we erase a vertex of the convex hull(2d) the
+    interior points that were hidden by it come back. It is the structure of Overmars and van Leeuwen :
+    the points are the leaves of a balanced binary search tree in lexicographic order and every internal
+    node keeps the bridge between the upper hull of its left subtree and the upper hull of its right
+    subtree. The upper hull of a node is the upper hull of the left child up to the bridge and the upper
+    hull of the right child after the bridge. The bridge is found by a binary search on both children in
+    O(log(n)), so the insertion and the erasure of a point are O(log(n)^2) amortized because they update
+    the bridges of the path to the root and sometimes they rebuild a subtree to keep the tree balanced.
+    The lower hull is the upper hull of the opposite points, so we keep a second tree with them.
+    The convex hull(2d) is read as the CH2d_dlclist, with an iterator that goes in clockwise order starting
+    from the point with the minimum x and the minimum y.
+    Every node keeps also the number of the vertices of its upper hull and the sum of the cross products
+    of its edges, they are updated with the bridge in O(log(n)), so the size() and the area() are O(1)
+    as at the CH2d_dlclist. The vertices themselves are collected in O(h*log(n)) at the first begin(),
+    end() or vertices() after an update and they are kept until the next update, the collection is
+    guarded by a mutex so the const functions can be called by many threads at the same time. The
+    insert() and the erase() must not run in parallel with anything else.
+
+    @author Chaviaras Michalis
+    @version 1.1  2/2018
+*/
+#ifndef CH2D_DYNAMICDEF
+#define CH2D_DYNAMICDEF
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <utility>
+#include "../basic/Point2d.hpp"
+#include "../preds/Predicates.hpp"
+
+
+class CH2d_dynamic{
+private:
+
+	/**
+	 * The balanced binary search tree of Overmars and van Leeuwen for the upper hull of a set of
+	 * different points.
+	 */
+	class upper_hull_tree{
+		struct Node{
+			Node* left;         // the left child, 0 if it is a leaf
+			Node* right;        // the right child, 0 if it is a leaf
+			Node* parent;       // the parent, 0 if it is the root
+			unsigned int size;  // the number of the leaves of the subtree
+			Point2d point;      // if it is a leaf contains the point, otherwise the first point of the right subtree
+			Point2d min_point;  // the first point of the subtree lexicographically
+			Point2d max_point;  // the last point of the subtree lexicographically
+			const Node* bri_left;  // the leaf of the left subtree that is the left end of the bridge
+			const Node* bri_right; // the leaf of the right subtree that is the right end of the bridge
+			unsigned int hull_size; // the number of the vertices of the upper hull of the subtree
+			double hull_cross;      // the sum of the cross products of the edges of the upper hull, with respect to origin
+		};
+
+		/**
+		 * A part of the upper hull of a node that starts or ends at a vertex.
+		 */
+		struct chain{
+			unsigned int size;  // the number of the vertices
+			double cross;       // the sum of the cross products of the edges, with respect to origin
+		};
+
+		Node* root;
+		Point2d origin;     // the origin of the cross products, a point of the tree when the root was built
+		lexicographic_comp less;
+
+		/**
+		 * @returns > 0 if p_1, p_2, p_3 make a counter clockwise turn
+		 */
+		static double ccw(const Point2d& p_1, const Point2d& p_2, const Point2d& p_3)
+		{
+			return -Predicates::getSignedOrientation(p_1,p_2,p_3);
+		}
+
+		/**
+		 * It finds the bridge of an internal node with the case analysis of Overmars and van Leeuwen.
+		 * At every step we have an edge ab of the upper hull of the left side and an edge cd of the
+		 * upper hull of the right side (a = b or c = d if it is a leaf) and we throw away the half
+		 * of one of the sides that can't contain the end of the bridge.
+		 * @param nod an internal node with correct children
+		 */
+		void find_bridge(Node* nod)
+		{
+			const Node* u = nod->left;
+			const Node* v = nod->right;
+			//a vertical line that separates the two sides, if the two sides touch it the points on it
+			//are separated lexicographically at the height sep_y
+			double sep = (u->max_point.GetX() + v->min_point.GetX())/2.0;
+			double sep_y = (u->max_point.GetY() + v->min_point.GetY())/2.0;
+			bool touch = (u->max_point.GetX() == v->min_point.GetX());
+			while( u->left != 0 || v->left != 0 )
+			{
+				bool u_leaf = (u->left == 0);
+				bool v_leaf = (v->left == 0);
+				const Point2d& a = u_leaf ? u->point : u->bri_left->point;
+				const Point2d& b = u_leaf ? u->point : u->bri_right->point;
+				const Point2d& c = v_leaf ? v->point : v->bri_left->point;
+				const Point2d& d = v_leaf ? v->point : v->bri_right->point;
+				if( !u_leaf && ccw(a,b,c) >= 0 )
+				{
+					//c is above the line ab so b can't be the end of the bridge
+					u = u->left;
+				}else if( !v_leaf && ccw(b,c,d) >= 0 )
+				{
+					//b is above the line cd so c can't be the end of the bridge
+					v = v->right;
+				}else if( u_leaf )
+				{
+					v = v->left;
+				}else if( v_leaf )
+				{
+					u = u->right;
+				}else
+				{
+					//the lines ab and cd meet, if they meet at the left side the end of the bridge
+					//is at the right of a, otherwise it is at the left of d
+					double dist_c = ccw(a,b,c);
+					double dist_d = ccw(a,b,d);
+					double denom = dist_c - dist_d;
+					double meet_x = (denom == 0) ? sep : (dist_c*d.GetX() - dist_d*c.GetX())/denom;
+					double meet_y = (denom == 0) ? sep_y : (dist_c*d.GetY() - dist_d*c.GetY())/denom;
+					if( meet_x < sep || (meet_x == sep && (!touch || meet_y <= sep_y)) )
+					{
+						u = u->right;
+					}else
+					{
+						v = v->left;
+					}
+				}
+			}
+			nod->bri_left = u;
+			nod->bri_right = v;
+		}
+
+		/**
+		 * @returns the cross product of the edge from p_1 to p_2 with respect to the origin
+		 */
+		double cross(const Point2d& p_1, const Point2d& p_2) const
+		{
+			return (p_1.GetX()-origin.GetX())*(p_2.GetY()-origin.GetY()) - (p_1.GetY()-origin.GetY())*(p_2.GetX()-origin.GetX());
+		}
+
+		/**
+		 * The upper hull of the node is split at the vertex "poi" into the prefix and the suffix, they
+		 * share "poi" so the hull_size is the sum of their sizes minus 1 and the hull_cross is the sum
+		 * of their cross. So we descend to the child that has "poi" at its upper hull and we take the
+		 * other part from the node, the prefix and the suffix call each other and they follow one path.
+		 * @param nod the node
+		 * @param poi a vertex of the upper hull of the node
+		 * @returns the vertices of the upper hull of the node up to "poi" (inclusive)
+		 */
+		chain prefix(const Node* nod, const Point2d& poi) const
+		{
+			chain res = {1, 0};
+			if( nod->left == 0 )
+			{
+				return res;
+			}
+			if( !less(nod->bri_left->point,poi) )
+			{
+				return prefix(nod->left,poi);
+			}
+			chain suf = suffix(nod->right,poi);
+			res.size = nod->hull_size - suf.size + 1;
+			res.cross = nod->hull_cross - suf.cross;
+			return res;
+		}
+
+		/**
+		 * @param nod the node
+		 * @param poi a vertex of the upper hull of the node
+		 * @returns the vertices of the upper hull of the node from "poi" (inclusive), see prefix
+		 */
+		chain suffix(const Node* nod, const Point2d& poi) const
+		{
+			chain res = {1, 0};
+			if( nod->left == 0 )
+			{
+				return res;
+			}
+			if( !less(poi,nod->bri_right->point) )
+			{
+				return suffix(nod->right,poi);
+			}
+			chain pre = prefix(nod->left,poi);
+			res.size = nod->hull_size - pre.size + 1;
+			res.cross = nod->hull_cross - pre.cross;
+			return res;
+		}
+
+		/**
+		 * It updates the size, the first and the last point, the bridge and the upper hull sums of an
+		 * internal node, O(log(n)).
+		 */
+		void update(Node* nod)
+		{
+			nod->size = nod->left->size + nod->right->size;
+			nod->min_point = nod->left->min_point;
+			nod->max_point = nod->right->max_point;
+			nod->point = nod->right->min_point;
+			find_bridge(nod);
+			chain pre = prefix(nod->left,nod->bri_left->point);
+			chain suf = suffix(nod->right,nod->bri_right->point);
+			nod->hull_size = pre.size + suf.size;
+			nod->hull_cross = pre.cross + suf.cross + cross(nod->bri_left->point,nod->bri_right->point);
+		}
+
+		/**
+		 * @returns true if the subtree of the node is not balanced, i.e one child has more than 3/4
+		 * of the leaves
+		 */
+		static bool unbalanced(const Node* nod)
+		{
+			return nod->size > 4 && 4*std::max(nod->left->size,nod->right->size) > 3*nod->size;
+		}
+
+		/**
+		 * It puts the leaves of a subtree in "leaves" in lexicographic order and deletes the internal nodes.
+		 */
+		static void take_leaves(Node* nod, std::vector<Node*>& leaves)
+		{
+			if( nod->left == 0 )
+			{
+				leaves.push_back(nod);
+				return;
+			}
+			take_leaves(nod->left,leaves);
+			take_leaves(nod->right,leaves);
+			delete nod;
+		}
+
+		/**
+		 * It builds a perfectly balanced subtree from the leaves at the positions from lo to hi-1.
+		 * @returns the root of the subtree
+		 */
+		Node* build(const std::vector<Node*>& leaves, int lo, int hi)
+		{
+			if( hi - lo == 1 )
+			{
+				return leaves[lo];
+			}
+			int mid = (lo+hi)/2;
+			Node* nod = new Node;
+			nod->left = build(leaves,lo,mid);
+			nod->right = build(leaves,mid,hi);
+			nod->left->parent = nod;
+			nod->right->parent = nod;
+			update(nod);
+			return nod;
+		}
+
+		/**
+		 * @returns true if the point, which is a vertex of the upper hull of the child of the node that
+		 * contains it, is a vertex of the upper hull of the node too
+		 */
+		bool stays_on_hull(const Node* nod, const Point2d& poi) const
+		{
+			if( less(poi,nod->point) )
+			{
+				return !less(nod->bri_left->point,poi);
+			}
+			return !less(poi,nod->bri_right->point);
+		}
+
+		/**
+		 * @returns true if the point, which is a leaf of the subtree of the node, is a vertex of its upper hull
+		 */
+		bool on_hull(const Node* nod, const Point2d& poi) const
+		{
+			while( nod->left != 0 )
+			{
+				if( !stays_on_hull(nod,poi) )
+				{
+					return false;
+				}
+				nod = less(poi,nod->point) ? nod->left : nod->right;
+			}
+			return true;
+		}
+
+		/**
+		 * It rebuilds the highest subtree of the path from the node to the root that is not balanced.
+		 * @returns the root of the rebuilt subtree or 0 if all the path is balanced
+		 */
+		Node* rebalance(Node* nod)
+		{
+			Node* highest = 0;
+			for( Node* curr = nod; curr != 0; curr = curr->parent )
+			{
+				if( unbalanced(curr) )
+				{
+					highest = curr;
+				}
+			}
+			if( highest == 0 )
+			{
+				return 0;
+			}
+			Node* parent = highest->parent;
+			std::vector<Node*> leaves;
+			take_leaves(highest,leaves);
+			if( parent == 0 )
+			{
+				//all the sums are calculated again, so the origin follows the points and the cross
+				//products stay small when the points move away, e.g at the CH2d_window
+				origin = leaves[0]->point;
+			}
+			Node* rebuilt = build(leaves,0,leaves.size());
+			rebuilt->parent = parent;
+			if( parent == 0 )
+			{
+				root = rebuilt;
+			}else if( parent->left == highest )
+			{
+				parent->left = rebuilt;
+			}else
+			{
+				parent->right = rebuilt;
+			}
+			return rebuilt;
+		}
+
+		/**
+		 * It updates the path from the node to the root after the insertion or the erasure of the point
+		 * poi and rebuilds a subtree if it is needed. The bridge of a node is calculated again only if
+		 * the upper hull of its child changed, i.e if poi is or was a vertex of it, otherwise the upper
+		 * hulls above don't change and only the sizes are updated. So a point that falls inside the
+		 * convex hull costs O(log(n)) and not O(log(n)^2).
+		 * @param nod the lowest internal node of which the subtree changed
+		 * @param inserted true if poi was inserted, false if it was erased
+		 * @param changed true if the upper hull of the child of nod changed
+		 * @param last after an erasure, the highest node of which the bridge must be calculated again,
+		 * 0 if it is the root
+		 */
+		void fix_path(Node* nod, const Point2d& poi, bool inserted, bool changed, const Node* last)
+		{
+			for( Node* curr = nod; curr != 0; curr = curr->parent )
+			{
+				curr->size = curr->left->size + curr->right->size;
+			}
+			Node* rebuilt = rebalance(nod);
+			if( rebuilt != 0 )
+			{
+				//the rebuilt subtree has new bridges, above it nothing changed if the upper hull
+				//of the subtree is the same
+				nod = rebuilt->parent;
+				if( inserted )
+				{
+					changed = on_hull(rebuilt,poi);
+				}else if( changed && last != 0 )
+				{
+					changed = false;
+					for( Node* curr = nod; curr != 0; curr = curr->parent )
+					{
+						if( curr == last )
+						{
+							changed = true;
+						}
+					}
+				}
+			}
+			for( Node* curr = nod; curr != 0 && changed; curr = curr->parent )
+			{
+				update(curr);
+				changed = inserted ? stays_on_hull(curr,poi) : (curr != last);
+			}
+		}
+
+		/**
+		 * It puts to "vertices" the vertices of the upper hull of the subtree of the node which
+		 * are between "from" and "to" (inclusive) lexicographically.
+		 */
+		void collect(const Node* nod, const Point2d& from, const Point2d& to, std::vector<Point2d>& vertices) const
+		{
+			if( nod->left == 0 )
+			{
+				vertices.push_back(nod->point);
+				return;
+			}
+			const Point2d& bri_left = nod->bri_left->point;
+			const Point2d& bri_right = nod->bri_right->point;
+			if( !less(bri_left,from) )
+			{
+				collect(nod->left,from,less(to,bri_left) ? to : bri_left,vertices);
+			}
+			if( !less(to,bri_right) )
+			{
+				collect(nod->right,less(from,bri_right) ? bri_right : from,to,vertices);
+			}
+		}
+
+		/**
+		 * @returns a new leaf with the point
+		 */
+		static Node* new_leaf(const Point2d& poi)
+		{
+			Node* leaf = new Node;
+			leaf->left = 0;
+			leaf->right = 0;
+			leaf->parent = 0;
+			leaf->size = 1;
+			leaf->point = poi;
+			leaf->min_point = poi;
+			leaf->max_point = poi;
+			leaf->hull_size = 1;
+			leaf->hull_cross = 0;
+			return leaf;
+		}
+
+		/**
+		 * It deletes all the nodes of the subtree.
+		 */
+		static void destroy(Node* nod)
+		{
+			if( nod == 0 )
+			{
+				return;
+			}
+			destroy(nod->left);
+			destroy(nod->right);
+			delete nod;
+		}
+
+	public:
+		upper_hull_tree()
+		{
+			root = 0;
+		}
+
+		~upper_hull_tree()
+		{
+			destroy(root);
+		}
+
+		/**
+		 * It inserts a point that is not in the tree, O(log(n)^2) amortized.
+		 */
+		void insert(const Point2d& poi)
+		{
+			Node* leaf = new_leaf(poi);
+			if( root == 0 )
+			{
+				root = leaf;
+				origin = poi;
+				return;
+			}
+			Node* curr = root;
+			while( curr->left != 0 )
+			{
+				curr = less(poi,curr->point) ? curr->left : curr->right;
+			}
+			//the leaf "curr" is replaced by an internal node with children the "curr" and the new leaf
+			Node* nod = new Node;
+			nod->parent = curr->parent;
+			if( curr->parent == 0 )
+			{
+				root = nod;
+			}else if( curr->parent->left == curr )
+			{
+				curr->parent->left = nod;
+			}else
+			{
+				curr->parent->right = nod;
+			}
+			if( less(poi,curr->point) )
+			{
+				nod->left = leaf;
+				nod->right = curr;
+			}else
+			{
+				nod->left = curr;
+				nod->right = leaf;
+			}
+			leaf->parent = nod;
+			curr->parent = nod;
+			fix_path(nod,poi,true,true,0);
+		}
+
+		/**
+		 * It builds the tree from different points in lexicographic order, the tree must be empty. The
+		 * update of a node is O(log(size of its subtree)), so the whole building is O(n).
+		 * @param sorted the points
+		 */
+		void assign(const std::vector<Point2d>& sorted)
+		{
+			assert( root == 0 );
+			if( sorted.empty() )
+			{
+				return;
+			}
+			std::vector<Node*> leaves(sorted.size());
+			for( std::size_t i = 0; i < sorted.size(); i++ )
+			{
+				leaves[i] = new_leaf(sorted[i]);
+			}
+			origin = sorted[0];
+			root = build(leaves,0,leaves.size());
+			root->parent = 0;
+		}
+
+		/**
+		 * It erases a point that is in the tree, O(log(n)^2) amortized.
+		 */
+		void erase(const Point2d& poi)
+		{
+			Node* curr = root;
+			while( curr->left != 0 )
+			{
+				curr = less(poi,curr->point) ? curr->left : curr->right;
+			}
+			assert( curr->point == poi );
+			Node* parent = curr->parent;
+			if( parent == 0 )
+			{
+				delete curr;
+				root = 0;
+				return;
+			}
+			//the bridges change up to the lowest node that doesn't have the point to its upper hull
+			bool changed = stays_on_hull(parent,poi);
+			const Node* last = 0;
+			for( const Node* anc = parent->parent; anc != 0 && changed && last == 0; anc = anc->parent )
+			{
+				if( !stays_on_hull(anc,poi) )
+				{
+					last = anc;
+				}
+			}
+			//the parent is replaced by the sibling
+			Node* sibling = (parent->left == curr) ? parent->right : parent->left;
+			delete curr;
+			Node* grand = parent->parent;
+			sibling->parent = grand;
+			if( grand == 0 )
+			{
+				root = sibling;
+			}else if( grand->left == parent )
+			{
+				grand->left = sibling;
+			}else
+			{
+				grand->right = sibling;
+			}
+			delete parent;
+			if( grand != 0 )
+			{
+				fix_path(grand,poi,false,changed,last);
+			}
+		}
+
+		/**
+		 * @returns the vertices of the upper hull from the first point to the last point lexicographically,
+		 * in O(h*log(n)) where h is the number of the vertices
+		 */
+		std::vector<Point2d> vertices() const
+		{
+			std::vector<Point2d> res;
+			if( root != 0 )
+			{
+				collect(root,root->min_point,root->max_point,res);
+			}
+			return res;
+		}
+
+		/**
+		 * @returns the number of the vertices of the upper hull, O(1)
+		 */
+		unsigned int hull_size() const
+		{
+			return (root == 0) ? 0 : root->hull_size;
+		}
+
+		/**
+		 * The sum of the cross products with respect to a point o is the sum with respect to the
+		 * origin plus the cross product of the vector from o to the origin with the vector from the
+		 * first to the last vertex, because the edges of the upper hull are a chain.
+		 * @param o a point
+		 * @returns the sum of the cross products (a-o)x(b-o) of the edges ab of the upper hull, O(1)
+		 */
+		double hull_cross(const Point2d& o) const
+		{
+			if( root == 0 )
+			{
+				return 0;
+			}
+			double dx = root->max_point.GetX() - root->min_point.GetX();
+			double dy = root->max_point.GetY() - root->min_point.GetY();
+			return root->hull_cross + (origin.GetX()-o.GetX())*dy - (origin.GetY()-o.GetY())*dx;
+		}
+
+		void clear()
+		{
+			destroy(root);
+			root = 0;
+		}
+
+		void swap(upper_hull_tree& other_tree) noexcept
+		{
+			std::swap(root,other_tree.root);
+			std::swap(origin,other_tree.origin);
+		}
+
+	private:
+		//the tree can't be copied, the CH2d_dynamic inserts the points to a new tree
+		upper_hull_tree(const upper_hull_tree&);
+		upper_hull_tree& operator=(const upper_hull_tree&);
+	};
+
+	upper_hull_tree my_upper;   // the tree of the points
+	upper_hull_tree my_lower;   // the tree of the opposite points, its upper hull is the lower hull
+	std::map<Point2d,unsigned int,lexicographic_comp> my_points; // the points with their multiplicity
+	unsigned int my_points_size;    // the number of the points with their multiplicity
+
+	// the vertices of the convex hull(2d) are collected when we read them after an update, the
+	// const functions that collect them lock my_vertices_mutex
+	mutable bool my_valid;
+	mutable std::vector<Point2d> my_vertices;
+	mutable unsigned int my_tail;
+	mutable std::mutex my_vertices_mutex;
+
+	/**
+	 * It collects the vertices of the convex hull(2d) in clockwise order and the tail, O(h*log(n)).
+	 * The caller must hold my_vertices_mutex.
+	 */
+	void notify() const
+	{
+		if( my_valid )
+		{
+			return;
+		}
+		my_vertices = my_upper.vertices();
+		std::vector<Point2d> low = my_lower.vertices();
+		for( int i = 1; i < (int)low.size()-1; i++ )
+		{
+			my_vertices.push_back(-low[i]);
+		}
+		//the tail is the point with the maximum x and the minimum y, with two points the tail is
+		//the point that is not the head as the CH2d_dlclist does
+		int siz = my_vertices.size();
+		my_tail = 0;
+		for( int i = 1; i < siz; i++ )
+		{
+			if( siz == 2 || my_vertices[i].GetX() > my_vertices[my_tail].GetX() ||
+			    (my_vertices[i].GetX() == my_vertices[my_tail].GetX() && my_vertices[i].GetY() < my_vertices[my_tail].GetY()) )
+			{
+				my_tail = i;
+			}
+		}
+		my_valid = true;
+	}
+
+	/**
+	 * It builds the two trees from different points in lexicographic order, they must be empty.
+	 */
+	void assign_trees(const std::vector<Point2d>& sorted)
+	{
+		my_upper.assign(sorted);
+		//the opposite points are in the reverse lexicographic order
+		std::vector<Point2d> opposite(sorted.size());
+		for( std::size_t i = 0; i < sorted.size(); i++ )
+		{
+			opposite[sorted.size()-1-i] = -sorted[i];
+		}
+		my_lower.assign(opposite);
+	}
+
+public:
+	/**
+	 * The iterator reads the vertices of the convex hull(2d) in clockwise order as the iterator of
+	 * the CH2d_dlclist, after the last vertex is the first again. It is valid until the next insertion
+	 * or erasure.
+	 */
+	class ch_iterator{
+	private:
+		const std::vector<Point2d>* vec;
+		unsigned int pos;
+	public:
+		ch_iterator(){vec = 0; pos = 0;}
+		ch_iterator(const std::vector<Point2d>* v, unsigned int x) {vec = v; pos = x;}
+		ch_iterator(const ch_iterator& other_it) {vec = other_it.vec; pos = other_it.pos;}
+		ch_iterator& operator++() {pos = (pos+1)%vec->size(); return *(this);}
+		ch_iterator operator++(int) {ch_iterator tmp(*(this)); operator++(); return tmp; }
+		ch_iterator& operator--() {pos = (pos+vec->size()-1)%vec->size(); return *(this);}
+		ch_iterator operator--(int) {ch_iterator tmp(*(this)); operator--(); return tmp; }
+		bool operator==(const ch_iterator& other_it) const {return vec == other_it.vec && pos == other_it.pos;}
+		bool operator!=(const ch_iterator& other_it) const {return !(*this == other_it);}
+		ch_iterator& operator=(const ch_iterator& other_ch_it){vec = other_ch_it.vec; pos = other_ch_it.pos; return *this;}
+		Point2d operator*() const {return (*vec)[pos];}
+		ch_iterator operator+(const unsigned int num) const {return ch_iterator(vec,(pos+num)%vec->size());}
+		ch_iterator operator-(const unsigned int num) const {return ch_iterator(vec,(pos+vec->size()-num%vec->size())%vec->size());}
+	};
+
+	/**
+	 *   Default Constructor
+	 */
+	CH2d_dynamic()
+	{
+		my_points_size = 0;
+		my_valid = false;
+		my_tail = 0;
+	}
+
+	/**
+	 * It sorts the points and builds the trees bottom up, in O(n*log(n)) instead of n insertions.
+	 * @param points the initial set of points
+	 */
+	CH2d_dynamic(const std::vector<Point2d>& points)
+	{
+		my_points_size = points.size();
+		my_valid = false;
+		my_tail = 0;
+		std::vector<Point2d> sorted(points);
+		std::sort(sorted.begin(),sorted.end(),lexicographic_comp());
+		std::vector<Point2d> distinct;
+		for( std::size_t i = 0; i < sorted.size(); i++ )
+		{
+			if( distinct.empty() || !(distinct.back() == sorted[i]) )
+			{
+				distinct.push_back(sorted[i]);
+				my_points.insert(my_points.end(),std::make_pair(sorted[i],0u));
+			}
+			my_points.rbegin()->second++;
+		}
+		assign_trees(distinct);
+	}
+
+	/**
+	 * Copy Constructor, it builds the trees from the points of the other_ch in O(n).
+	 */
+	CH2d_dynamic(const CH2d_dynamic& other_ch)
+	{
+		my_points_size = 0;
+		my_valid = false;
+		my_tail = 0;
+		*this = other_ch;
+	}
+
+	/**
+	 * Assignment Operator, it builds the trees from the points of the other_ch in O(n).
+	 */
+	CH2d_dynamic& operator=(const CH2d_dynamic& other_ch)
+	{
+		if( this != &other_ch )
+		{
+			my_upper.clear();
+			my_lower.clear();
+			my_points = other_ch.my_points;
+			my_points_size = other_ch.my_points_size;
+			my_valid = false;
+			std::vector<Point2d> distinct;
+			distinct.reserve(my_points.size());
+			std::map<Point2d,unsigned int,lexicographic_comp>::const_iterator it;
+			for( it = my_points.begin(); it != my_points.end(); it++ )
+			{
+				distinct.push_back(it->first);
+			}
+			assign_trees(distinct);
+		}
+		return *this;
+	}
+
+	/**
+	 * Move Constructor, it takes the trees of the other_ch in O(1), the other_ch becomes empty.
+	 */
+	CH2d_dynamic(CH2d_dynamic&& other_ch) noexcept
+	{
+		my_points_size = 0;
+		my_valid = false;
+		my_tail = 0;
+		swap(other_ch);
+	}
+
+	/**
+	 * Move Assignment Operator, it swaps the trees with the other_ch in O(1).
+	 */
+	CH2d_dynamic& operator=(CH2d_dynamic&& other_ch) noexcept
+	{
+		swap(other_ch);
+		return *this;
+	}
+
+	/**
+	 * It swaps two convex hulls(2d) in O(1), the iterators follow the vertices. It must not run in
+	 * parallel with anything else on the two convex hulls(2d).
+	 */
+	void swap(CH2d_dynamic& other_ch) noexcept
+	{
+		my_upper.swap(other_ch.my_upper);
+		my_lower.swap(other_ch.my_lower);
+		my_points.swap(other_ch.my_points);
+		std::swap(my_points_size,other_ch.my_points_size);
+		std::swap(my_valid,other_ch.my_valid);
+		my_vertices.swap(other_ch.my_vertices);
+		std::swap(my_tail,other_ch.my_tail);
+	}
+
+	/**
+	 * It inserts a point, O(log(n)^2) amortized. The same point may be inserted many times.
+	 * @param poi the point that will be inserted
+	 */
+	void insert(const Point2d& poi)
+	{
+		unsigned int& count = my_points[poi];
+		if( count == 0 )
+		{
+			my_upper.insert(poi);
+			my_lower.insert(-poi);
+			my_valid = false;
+		}
+		count++;
+		my_points_size++;
+	}
+
+	/**
+	 * It erases a point, O(log(n)^2) amortized. If the point was inserted many times it erases one
+	 * of them. If a vertex of the convex hull(2d) is erased the points that it was hiding may become
+	 * vertices.
+	 * @param poi the point that will be erased
+	 * @returns false if the point is not in the set
+	 */
+	bool erase(const Point2d& poi)
+	{
+		std::map<Point2d,unsigned int,lexicographic_comp>::iterator it = my_points.find(poi);
+		if( it == my_points.end() )
+		{
+			return false;
+		}
+		if( --(it->second) == 0 )
+		{
+			my_points.erase(it);
+			my_upper.erase(poi);
+			my_lower.erase(-poi);
+			my_valid = false;
+		}
+		my_points_size--;
+		return true;
+	}
+
+	/**
+	 * @returns the number of the points of the set, with their multiplicity
+	 */
+	unsigned int points_size() const
+	{
+		return my_points_size;
+	}
+
+	/**
+	 * The upper hull and the lower hull share the first and the last point lexicographically.
+	 * @returns the number of the vertices of the convex hull(2d), O(1)
+	 */
+	unsigned int size() const
+	{
+		if( my_points.size() < 2 )
+		{
+			return my_points.size();
+		}
+		return my_upper.hull_size() + my_lower.hull_size() - 2;
+	}
+
+	/**
+	 * @returns the point with the minimum x and the minimum y, O(h*log(n)) after an update
+	 */
+	ch_iterator begin() const
+	{
+		std::lock_guard<std::mutex> lock(my_vertices_mutex);
+		notify();
+		assert( my_vertices.size() > 0 );
+		return ch_iterator(&my_vertices,0);
+	}
+
+	/**
+	 * @returns the point with the maximum x, and the minimum y, O(h*log(n)) after an update
+	 */
+	ch_iterator end() const
+	{
+		std::lock_guard<std::mutex> lock(my_vertices_mutex);
+		notify();
+		assert( my_vertices.size() > 0 );
+		return ch_iterator(&my_vertices,my_tail);
+	}
+
+	/**
+	 * The clockwise boundary is the upper hull and the lower hull, which is the upper hull of the
+	 * opposite points, the cross product of two opposite points is the same with respect to the
+	 * opposite origin, so the sums of the two trees are added with respect to the head.
+	 * @returns the area of the convex hull(2d), O(1)
+	 */
+	double area() const
+	{
+		if( my_points.size() < 3 )
+		{
+			return 0;
+		}
+		const Point2d& head = my_points.begin()->first;
+		return std::abs(my_upper.hull_cross(head) + my_lower.hull_cross(-head))/2.0;
+	}
+
+	/**
+	 * @returns the vertices of the convex hull(2d) in clockwise order starting from the point with
+	 * the minimum x and the minimum y, O(h*log(n)) after an update
+	 */
+	std::vector<Point2d> vertices() const
+	{
+		std::lock_guard<std::mutex> lock(my_vertices_mutex);
+		notify();
+		return my_vertices;
+	}
+};
+
+/**
+ * It swaps two convex hulls(2d) in O(1), see CH2d_dynamic::swap.
+ */
+inline void swap(CH2d_dynamic& ch_1, CH2d_dynamic& ch_2) noexcept
+{
+	ch_1.swap(ch_2);
+}
+
+
+#endif
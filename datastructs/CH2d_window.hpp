@@ -0,0 +1,183 @@
+/**
+    Purpose: To represent the convex hull of the most recent points of a stream of 2d points with
+    timestamps, the window is the last N points or the points of the last T seconds (or both). The
+    points of the window are kept in a queue in the order of their arrival and in a CH2d_dynamic, a new
+    point is inserted at the back and the oldest point is erased from the front, both in O(log(n)^2)
+    amortized, where n is the size of the window. So the convex hull(2d) of the window is never made
+    again from the start.
+    The convex hull(2d) is read as the CH2d_dlclist, with an iterator that goes in clockwise order starting
+    from the point with the minimum x and the minimum y.
+
+    @author Chaviaras Michalis
+    @version 1.1  4/2018
+*/
+#ifndef CH2D_WINDOWDEF
+#define CH2D_WINDOWDEF
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+#include "../basic/Point2d.hpp"
+#include "CH2d_dynamic.hpp"
+
+
+class CH2d_window{
+private:
+	std::deque< std::pair<Point2d,double> > my_window;  // the points of the window with their time, the oldest first
+	CH2d_dynamic my_ch;                                 // the convex hull(2d) of the points of the window
+	std::size_t my_max_points;                          // the maximum number of the points, 0 for no maximum
+	double my_max_age;                                  // the maximum age of the points, 0 for no maximum
+
+public:
+	typedef CH2d_dynamic::ch_iterator ch_iterator;
+
+	/**
+	 * @param max_points the window keeps at most this number of the last points, 0 for no maximum
+	 * @param max_age the window keeps the points with time greater than the time of the last point
+	 * minus max_age, 0 for no maximum
+	 * @throws std::invalid_argument if the max_age is negative
+	 */
+	explicit CH2d_window(std::size_t max_points = 0, double max_age = 0)
+	{
+		if( max_age < 0 )
+		{
+			throw std::invalid_argument( "The maximum age of the points of the CH2d_window is negative" );
+		}
+		my_max_points = max_points;
+		my_max_age = max_age;
+	}
+
+	/**
+	 * It pushes a new point at the back of the window, the points that are out of the window after it
+	 * are popped from the front. O(log(n)^2) amortized for every point that is pushed or popped.
+	 * @param poi the point
+	 * @param time the time of the point, it must not be less than the time of the last point
+	 * @throws std::invalid_argument if the time is less than the time of the last point
+	 */
+	void push_back(const Point2d& poi, double time = 0)
+	{
+		if( !my_window.empty() && time < my_window.back().second )
+		{
+			throw std::invalid_argument( "The points of the CH2d_window must come in the order of their time" );
+		}
+		my_window.push_back(std::make_pair(poi,time));
+		my_ch.insert(poi);
+		if( my_max_points > 0 )
+		{
+			while( my_window.size() > my_max_points )
+			{
+				pop_front();
+			}
+		}
+		if( my_max_age > 0 )
+		{
+			expire(time - my_max_age);
+		}
+	}
+
+	/**
+	 * It pops the oldest point of the window, O(log(n)^2) amortized.
+	 */
+	void pop_front()
+	{
+		assert( !my_window.empty() );
+		my_ch.erase(my_window.front().first);
+		my_window.pop_front();
+	}
+
+	/**
+	 * It pops all the points of the window with time less than or equal to a time.
+	 * @param time the time
+	 * @returns the number of the points that were popped
+	 */
+	std::size_t expire(double time)
+	{
+		std::size_t popped = 0;
+		while( !my_window.empty() && my_window.front().second <= time )
+		{
+			pop_front();
+			popped++;
+		}
+		return popped;
+	}
+
+	/**
+	 * @returns the number of the points of the window
+	 */
+	std::size_t points_size() const
+	{
+		return my_window.size();
+	}
+
+	/**
+	 * @returns the number of the vertices of the convex hull(2d) of the window, O(1)
+	 */
+	unsigned int size() const
+	{
+		return my_ch.size();
+	}
+
+	/**
+	 * @returns the oldest point of the window and its time
+	 */
+	const std::pair<Point2d,double>& front() const
+	{
+		assert( !my_window.empty() );
+		return my_window.front();
+	}
+
+	/**
+	 * @returns the newest point of the window and its time
+	 */
+	const std::pair<Point2d,double>& back() const
+	{
+		assert( !my_window.empty() );
+		return my_window.back();
+	}
+
+	/**
+	 * @returns the point with the minimum x and the minimum y
+	 */
+	ch_iterator begin() const
+	{
+		return my_ch.begin();
+	}
+
+	/**
+	 * @returns the point with the maximum x, and the minimum y
+	 */
+	ch_iterator end() const
+	{
+		return my_ch.end();
+	}
+
+	/**
+	 * @returns the area of the convex hull(2d) of the window, O(1)
+	 */
+	double area() const
+	{
+		return my_ch.area();
+	}
+
+	/**
+	 * @returns the vertices of the convex hull(2d) of the window in clockwise order starting from
+	 * the point with the minimum x and the minimum y
+	 */
+	std::vector<Point2d> vertices() const
+	{
+		return my_ch.vertices();
+	}
+
+	/**
+	 * @returns the convex hull(2d) of the window
+	 */
+	const CH2d_dynamic& hull() const
+	{
+		return my_ch;
+	}
+};
+
+
+#endif
@@ -0,0 +1,445 @@
+/**
+ *   Purpose: To represent a 2d tree as the K2d_tree with a compact memory layout for the queries. The
+ *   K2d_tree keeps a node with two pointers, a split value and a point for every split and for every
+ *   point. Here the tree is complete, every leaf is at the same depth and it has a bucket of at most
+ *   bucket_size points (8 to 32 is good), so there are no pointers : the split values of the internal
+ *   nodes are in one array in BFS order, the children of the node i are the 2*i+1 and the 2*i+2, and
+ *   the points are in two arrays (the x coordinates and the y coordinates) in the order of the leaves.
+ *   The points of a subtree are contiguous and their number is known from the depth, so a subtree
+ *   inside a query rectangle is reported (or counted) without walking it. The split coordinate is x
+ *   at the even depths and y at the odd depths as in the K2d_tree. The left child has the points with
+ *   coordinate less than or equal to the split value and the right child the points with coordinate
+ *   greater than or equal to it, so the points may have equal coordinates.
+ *
+ *   @author Chaviaras Michalis
+ *   @version 1.1  6/2018
+ *
+ */
+
+#ifndef K2D_FLAT_TREEDEF
+#define K2D_FLAT_TREEDEF
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include "../basic/Point2d.hpp"
+
+
+class K2d_flat_tree{
+private:
+	std::vector<double> my_split;   // the split values of the internal nodes in BFS order
+	std::vector<double> my_x;       // the x coordinates of the points in the order of the leaves
+	std::vector<double> my_y;       // the y coordinates of the points in the order of the leaves
+	unsigned int my_depth;          // the depth of the leaves, the root has depth 0
+	unsigned int my_bucket_size;    // the maximum number of the points of a leaf
+
+	/**
+	 *  The rectangle of a query or the region of a node, the boundary is included.
+	 */
+	struct Box{
+		double xmin;
+		double xmax;
+		double ymin;
+		double ymax;
+	};
+
+	Box my_bounds;                  // the bounding box of the points, the region of the root
+
+	/**
+	 *  A point of the k nearest neighbours with the square of its distance from the query point.
+	 */
+	struct Neighbour{
+		double dist2;
+		std::size_t pos;
+		bool operator<(const Neighbour& other) const {return dist2 < other.dist2;}
+	};
+
+	/**
+	 *  The comparison of the points by the x or the y coordinate for the median selection.
+	 */
+	struct CompCoord{
+		bool by_x;
+		bool operator()(const Point2d& a, const Point2d& b) const
+		{
+			return by_x ? a.GetX() < b.GetX() : a.GetY() < b.GetY();
+		}
+	};
+
+	/**
+	 *  @returns the position of the first point of the right child of a node with the points from
+	 *  lo to hi, the left child takes the half of the points rounded up as in the K2d_tree
+	 */
+	static std::size_t middle(std::size_t lo, std::size_t hi)
+	{
+		return lo + (hi - lo + 1)/2;
+	}
+
+	/**
+	 *  Here is practically the construction of the tree, the median of the points of the node is
+	 *  selected in linear time and the points are split around it.
+	 *  @param points the points, at the end they are in the order of the leaves
+	 *  @param nod the node in BFS order
+	 *  @param depth the depth of the node
+	 *  @param lo the position of the first point of the node
+	 *  @param hi the position after the last point of the node
+	 */
+	void BuildTree(std::vector<Point2d>& points, std::size_t nod, unsigned int depth, std::size_t lo, std::size_t hi)
+	{
+		if( depth == my_depth )
+		{
+			return;
+		}
+		std::size_t mid = middle(lo,hi);
+		if( mid > lo )
+		{
+			CompCoord comp;
+			comp.by_x = (depth%2 == 0);
+			//the points after the median are greater than or equal to it and the points before it
+			//are less than or equal to it, so the median is the maximum of the left child
+			std::nth_element(points.begin()+lo,points.begin()+mid-1,points.begin()+hi,comp);
+			my_split[nod] = comp.by_x ? points[mid-1].GetX() : points[mid-1].GetY();
+		}else
+		{
+			my_split[nod] = 0;
+		}
+		BuildTree(points,2*nod+1,depth+1,lo,mid);
+		BuildTree(points,2*nod+2,depth+1,mid,hi);
+	}
+
+	/**
+	 *  @returns true if the point at the position pos is inside the query rectangle
+	 */
+	bool insideQuery(std::size_t pos, const Box& query) const
+	{
+		return query.xmin <= my_x[pos] && my_x[pos] <= query.xmax &&
+		       query.ymin <= my_y[pos] && my_y[pos] <= query.ymax;
+	}
+
+	/**
+	 *  The below is an auxiliary function of the range search and of the range count. It goes down to
+	 *  the children whose regions meet the query rectangle, the points of a node whose region is inside
+	 *  the query are reported (or counted) whole and the points of a leaf are checked.
+	 *  @param nod the node
+	 *  @param depth the depth of the node
+	 *  @param lo the position of the first point of the node
+	 *  @param hi the position after the last point of the node
+	 *  @param region the region of the node
+	 *  @param query the query rectangle
+	 *  @param out the output iterator of the points, it is not used if count_only is true
+	 *  @param counter at the end it is increased by the number of the points of the node inside the query
+	 *  @param count_only true for the range count, false for the range search
+	 *  @returns the output iterator after the last point that was written
+	 */
+	template <class OutputIterator>
+	OutputIterator searchSubtree(std::size_t nod, unsigned int depth, std::size_t lo, std::size_t hi, Box region,
+	                             const Box& query, OutputIterator out, std::size_t& counter, bool count_only) const
+	{
+		if( region.xmin >= query.xmin && region.xmax <= query.xmax && region.ymin >= query.ymin && region.ymax <= query.ymax )
+		{
+			counter += hi - lo;
+			for( std::size_t i = lo; i < hi && !count_only; i++ )
+			{
+				*out = Point2d(my_x[i],my_y[i]);
+				++out;
+			}
+			return out;
+		}
+		if( depth == my_depth )
+		{
+			for( std::size_t i = lo; i < hi; i++ )
+			{
+				if( insideQuery(i,query) )
+				{
+					counter++;
+					if( !count_only )
+					{
+						*out = Point2d(my_x[i],my_y[i]);
+						++out;
+					}
+				}
+			}
+			return out;
+		}
+		double split_val = my_split[nod];
+		std::size_t mid = middle(lo,hi);
+		Box left_region = region;
+		Box right_region = region;
+		bool go_left;
+		bool go_right;
+		if( depth%2 == 0 )
+		{
+			left_region.xmax = split_val;
+			right_region.xmin = split_val;
+			go_left = split_val >= query.xmin;
+			go_right = split_val <= query.xmax;
+		}else
+		{
+			left_region.ymax = split_val;
+			right_region.ymin = split_val;
+			go_left = split_val >= query.ymin;
+			go_right = split_val <= query.ymax;
+		}
+		if( go_left && mid > lo )
+		{
+			out = searchSubtree(2*nod+1,depth+1,lo,mid,left_region,query,out,counter,count_only);
+		}
+		if( go_right && hi > mid )
+		{
+			out = searchSubtree(2*nod+2,depth+1,mid,hi,right_region,query,out,counter,count_only);
+		}
+		return out;
+	}
+
+	/**
+	 *  The below is an auxiliary function of the nearest. It goes down first to the child at the side
+	 *  of the query point and then to the other child only if the plane of the split is nearer than
+	 *  the farthest of the k nearest points that were found. The distances are squared.
+	 *  @param heap the nearest points that were found, it is a max-heap of at most k points
+	 */
+	void nearestSubtree(std::size_t nod, unsigned int depth, std::size_t lo, std::size_t hi, double q_x, double q_y,
+	                    unsigned int k, std::vector<Neighbour>& heap) const
+	{
+		if( depth == my_depth )
+		{
+			for( std::size_t i = lo; i < hi; i++ )
+			{
+				Neighbour nei;
+				nei.dist2 = (my_x[i] - q_x)*(my_x[i] - q_x) + (my_y[i] - q_y)*(my_y[i] - q_y);
+				nei.pos = i;
+				if( heap.size() < k )
+				{
+					heap.push_back(nei);
+					std::push_heap(heap.begin(),heap.end());
+				}else if( nei.dist2 < heap.front().dist2 )
+				{
+					std::pop_heap(heap.begin(),heap.end());
+					heap.back() = nei;
+					std::push_heap(heap.begin(),heap.end());
+				}
+			}
+			return;
+		}
+		std::size_t mid = middle(lo,hi);
+		double diff = ((depth%2 == 0) ? q_x : q_y) - my_split[nod];
+		//the child at the side of the query point and the other child with their points
+		std::size_t near_nod = (diff <= 0) ? 2*nod+1 : 2*nod+2;
+		std::size_t near_lo = (diff <= 0) ? lo : mid;
+		std::size_t near_hi = (diff <= 0) ? mid : hi;
+		std::size_t far_nod = (diff <= 0) ? 2*nod+2 : 2*nod+1;
+		std::size_t far_lo = (diff <= 0) ? mid : lo;
+		std::size_t far_hi = (diff <= 0) ? hi : mid;
+		if( near_hi > near_lo )
+		{
+			nearestSubtree(near_nod,depth+1,near_lo,near_hi,q_x,q_y,k,heap);
+		}
+		if( far_hi > far_lo && (heap.size() < k || diff*diff < heap.front().dist2) )
+		{
+			nearestSubtree(far_nod,depth+1,far_lo,far_hi,q_x,q_y,k,heap);
+		}
+	}
+
+	/**
+	 *  The below is an auxiliary function of the withinRadius, it goes down only to the children whose
+	 *  side of the plane of the split is not farther than the radius.
+	 *  @param radius2 the square of the radius
+	 *  @param res the points that were found
+	 */
+	void radiusSubtree(std::size_t nod, unsigned int depth, std::size_t lo, std::size_t hi, double q_x, double q_y,
+	                   double radius2, std::vector<Point2d>& res) const
+	{
+		if( depth == my_depth )
+		{
+			for( std::size_t i = lo; i < hi; i++ )
+			{
+				if( (my_x[i] - q_x)*(my_x[i] - q_x) + (my_y[i] - q_y)*(my_y[i] - q_y) <= radius2 )
+				{
+					res.push_back(Point2d(my_x[i],my_y[i]));
+				}
+			}
+			return;
+		}
+		std::size_t mid = middle(lo,hi);
+		double diff = ((depth%2 == 0) ? q_x : q_y) - my_split[nod];
+		if( (diff <= 0 || diff*diff <= radius2) && mid > lo )
+		{
+			radiusSubtree(2*nod+1,depth+1,lo,mid,q_x,q_y,radius2,res);
+		}
+		if( (diff >= 0 || diff*diff <= radius2) && hi > mid )
+		{
+			radiusSubtree(2*nod+2,depth+1,mid,hi,q_x,q_y,radius2,res);
+		}
+	}
+
+	/**
+	 *  @returns the query rectangle
+	 */
+	static Box makeBox(double xmin, double xmax, double ymin, double ymax)
+	{
+		Box box;
+		box.xmin = xmin;
+		box.xmax = xmax;
+		box.ymin = ymin;
+		box.ymax = ymax;
+		return box;
+	}
+
+
+
+public:
+	/**
+	 *  This constructor is the basic constructor. The depth of the leaves is the minimum depth that
+	 *  gives at most bucket_size points to every leaf, the split values are the medians. O(n*log(n)).
+	 *  @param points the points of the tree, they may have equal coordinates
+	 *  @param bucket_size the maximum number of the points of a leaf
+	 *  @throws std::invalid_argument if the bucket_size is less than 2
+	 */
+	K2d_flat_tree(std::vector<Point2d> points, unsigned int bucket_size = 16)
+	{
+		if( bucket_size < 2 )
+		{
+			throw std::invalid_argument( "The buckets of the K2d_flat_tree must have at least 2 points" );
+		}
+		my_bucket_size = bucket_size;
+		//the leaves have at most ceil(n/2^depth) points
+		my_depth = 0;
+		while( ((points.size() + (std::size_t(1) << my_depth) - 1) >> my_depth) > bucket_size )
+		{
+			my_depth++;
+		}
+		my_split.assign((std::size_t(1) << my_depth) - 1,0);
+		BuildTree(points,0,0,0,points.size());
+		my_x.resize(points.size());
+		my_y.resize(points.size());
+		for( std::size_t i = 0; i < points.size(); i++ )
+		{
+			my_x[i] = points[i].GetX();
+			my_y[i] = points[i].GetY();
+		}
+		if( !points.empty() )
+		{
+			my_bounds = makeBox(*std::min_element(my_x.begin(),my_x.end()),*std::max_element(my_x.begin(),my_x.end()),
+			                    *std::min_element(my_y.begin(),my_y.end()),*std::max_element(my_y.begin(),my_y.end()));
+		}else
+		{
+			my_bounds = makeBox(0,0,0,0);
+		}
+	}
+
+	/**
+	 *  The orthogonal range search, it finds the points of the tree inside the rectangle
+	 *  [xmin,xmax] x [ymin,ymax] (the boundary is included), see K2d_tree::rangeSearch.
+	 *  @returns the points inside the rectangle
+	 */
+	std::vector<Point2d> rangeSearch(double xmin, double xmax, double ymin, double ymax) const
+	{
+		std::vector<Point2d> res;
+		rangeSearch(xmin,xmax,ymin,ymax,std::back_inserter(res));
+		return res;
+	}
+
+	/**
+	 *  The orthogonal range search that writes the points to an output iterator, so it doesn't
+	 *  allocate anything.
+	 *  @param out the output iterator, a Point2d is written to it for every point inside the rectangle
+	 *  @returns the output iterator after the last point that was written
+	 */
+	template <class OutputIterator>
+	OutputIterator rangeSearch(double xmin, double xmax, double ymin, double ymax, OutputIterator out) const
+	{
+		if( my_x.empty() )
+		{
+			return out;
+		}
+		std::size_t counter = 0;
+		return searchSubtree(0,0,0,my_x.size(),my_bounds,makeBox(xmin,xmax,ymin,ymax),out,counter,false);
+	}
+
+	/**
+	 *  The orthogonal range count, it counts the points of the tree inside the rectangle
+	 *  [xmin,xmax] x [ymin,ymax] (the boundary is included). The number of the points of a node is
+	 *  known from its position, so the nodes whose regions are inside the rectangle are counted
+	 *  without walking them.
+	 *  @returns the number of the points inside the rectangle
+	 */
+	std::size_t rangeCount(double xmin, double xmax, double ymin, double ymax) const
+	{
+		if( my_x.empty() )
+		{
+			return 0;
+		}
+		std::size_t counter = 0;
+		searchSubtree(0,0,0,my_x.size(),my_bounds,makeBox(xmin,xmax,ymin,ymax),(Point2d*)0,counter,true);
+		return counter;
+	}
+
+	/**
+	 *  The k nearest neighbours of a point with branch and bound, see K2d_tree::nearest.
+	 *  @param query_po the query point
+	 *  @param k the number of the neighbours
+	 *  @returns the k nearest points of the tree (all the points if they are less than k) from the
+	 *  nearest to the farthest
+	 */
+	std::vector<Point2d> nearest(const Point2d& query_po, unsigned int k) const
+	{
+		std::vector<Point2d> res;
+		if( my_x.empty() || k == 0 )
+		{
+			return res;
+		}
+		std::vector<Neighbour> heap;
+		heap.reserve(std::min<std::size_t>(k,my_x.size()));
+		nearestSubtree(0,0,0,my_x.size(),query_po.GetX(),query_po.GetY(),k,heap);
+		std::sort_heap(heap.begin(),heap.end());
+		res.reserve(heap.size());
+		for( std::size_t i = 0; i < heap.size(); i++ )
+		{
+			res.push_back(Point2d(my_x[heap[i].pos],my_y[heap[i].pos]));
+		}
+		return res;
+	}
+
+	/**
+	 *  The fixed radius search, it finds the points of the tree whose distance from a point is less than
+	 *  or equal to the radius, see K2d_tree::withinRadius.
+	 *  @returns the points inside the circle, in no certain order
+	 */
+	std::vector<Point2d> withinRadius(const Point2d& query_po, double radius) const
+	{
+		std::vector<Point2d> res;
+		if( !my_x.empty() && radius >= 0 )
+		{
+			radiusSubtree(0,0,0,my_x.size(),query_po.GetX(),query_po.GetY(),radius*radius,res);
+		}
+		return res;
+	}
+
+	/**
+	 * @returns the number of the points of the tree
+	 */
+	std::size_t size() const
+	{
+		return my_x.size();
+	}
+
+	/**
+	 * @returns the depth of the leaves, the tree has 2^depth leaves
+	 */
+	unsigned int depth() const
+	{
+		return my_depth;
+	}
+
+	/**
+	 * @returns the number of the bytes of the memory of the tree
+	 */
+	std::size_t memoryFootprint() const
+	{
+		return sizeof(*this) + (my_split.capacity() + my_x.capacity() + my_y.capacity())*sizeof(double);
+	}
+};
+
+
+
+#endif
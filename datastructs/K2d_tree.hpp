@@ -15,8 +15,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cassert>
+#include <iterator>
+#include <limits>
 #include <stdexcept>   // for exception, runtime_error, out_of_range
+#include <functional>
+#include <thread>
 #include "../basic/Point2d.hpp"
+#include "thread_group.hpp"
 
 /**
  *   auxiliary functions that are used for sorting
@@ -34,9 +39,25 @@ class K2d_tree{
 		double split_val;   // contains the split value of the node, if it is a leaf is equal to 0.
 		bool is_leaf;       // answer to question if the node is a leaf.
 		Point2d data_leaf;  // if the node is a leaf contains the Point2d, otherwise contains the Point2d : (0,0).
+		unsigned int count; // the number of the leaves of the subtree of the node.
+	};
+
+	/**
+	 *  The rectangle of a query or the region of a node, for the region the minimums are not
+	 *  included because the points of the right child of a node are greater than its split value.
+	 */
+	struct Box{
+		double xmin;
+		double xmax;
+		double ymin;
+		double ymax;
 	};
 private:	
 	Node* root;                     // pointer to the root of the tree
+	std::vector<Node> my_nodes;     // the nodes of the tree in preorder, the root is the first
+	
+	// the parallel construction and the parallel sort don't split sets with less points than this
+	static const int PARALLEL_GRAIN = 1 << 15;
 	std::vector<Point2d> sort_by_x; // the points of the tree sorted by x
 	std::vector<Point2d> sort_by_y; // the points of the tree sorted by y
 	unsigned int my_size;           // the number of the leaves for which we constructed the tree
@@ -46,36 +67,25 @@ private:
 	 *  Here is practically the construction of the tree. 
 	 *  The parameter constructor call this function after the sorting of the points 
 	 *  with respect to x coordinate and y coordinate.
-	 *  @returns a node pointer to the root of the tree
+	 *  The tree of a set of siz points has 2*siz-1 nodes and they are given in preorder : the "nod" is
+	 *  the root, after it are the 2*left_siz-1 nodes of the left subtree and then the nodes of the right 
+	 *  subtree. The set is split to the first points of the points_by_x (or by_y) and to the rest, the 
+	 *  other sorting is split with a stable partition in place (the right points wait in the scratch),
+	 *  so the two sortings of every subtree are again contiguous and nothing is allocated.
 	 *  @param split is used to determine whether to split the current set with respect 
-	 *  to x or y coordinate, if split is an even number then we split by x coordinate otherwise
-	 *  we split by y coordinate.
+	 *  to x or y coordinate, if split is an even number then we split by y coordinate otherwise
+	 *  we split by x coordinate.
 	 *  @param points_by_x is the current set of the points sorted with respect to x coordinate
 	 *  @param points_by_y is the current set of the points sorted with respect to y coordinate
-	 *  points_by_x and points_by_y are referred to the same current set but to different sortings.
-	 *  If the current set contains one point then we have to make a leaf node.
-	 *  Else we have to split the current set and sort the resulted 2 sets with respect to x and y
-	 *  coordinate. So the vectors left_by_x, left_by_y, right_by_x, right_by_y keep the 2 set, the left one and
-	 *  the right one and the two sortings of them. We can create the last four vectors given the
-	 *  points_by_x and points_by_y are sorted. 
-	 *  
-	 * 
+	 *  points_by_x and points_by_y are referred to the same current set but to different sortings,
+	 *  they are changed.
+	 *  @param scratch memory for siz points
+	 *  @param siz the number of the points of the current set, at least 1
+	 *  @param nod the root of the subtree of the current set
 	 */
-	Node* BuildTree(int split, std::vector<Point2d> points_by_x, std::vector<Point2d> points_by_y)
+	static void BuildTree(int split, Point2d* points_by_x, Point2d* points_by_y, Point2d* scratch, int siz, Node* nod)
 	{
-		//points_by_x and points_by_y are referred to the same set but to different sorting
-		assert(points_by_x.size() == points_by_y.size());
-		int siz = points_by_x.size();
-		std::vector<Point2d> left_by_x;
-		std::vector<Point2d> left_by_y;
-		std::vector<Point2d> right_by_x;
-		std::vector<Point2d> right_by_y;
-		Node* nod = new Node;
-		if(points_by_x.size() == 0)
-		{
-			delete nod;
-			return 0;
-		}else if(points_by_x.size() == 1)
+		if( siz == 1 )
 		{
 			nod->left = 0;
 			nod->right = 0;
@@ -83,102 +93,571 @@ private:
 			nod->split_val = 0;
 			nod->is_leaf = true;
 			nod->data_leaf = points_by_x[0];
-			return nod;
-		}else
+			nod->count = 1;
+			return;
+		}
+		int num_left = SplitNode(split,points_by_x,points_by_y,scratch,siz,nod);
+		BuildTree(split+1,points_by_x,points_by_y,scratch,num_left,nod->left);
+		BuildTree(split+1,points_by_x+num_left,points_by_y+num_left,scratch+num_left,siz-num_left,nod->right);
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the SplitNode and the SplitNodeParallel, it sets the
+	 *  split of the internal node of a set of at least 2 points, the parameters are the same.
+	 *  @returns the position of the median at the sorting of the split coordinate
+	 */
+	static int InitInternalNode(int split, const Point2d* points_by_x, const Point2d* points_by_y, int siz, Node* nod)
+	{
+		int index_median = ceil(siz/2.0)-1;
+		const Point2d* sorted = (split%2 == 1) ? points_by_x : points_by_y;
+		nod->split_coord = (split%2 == 1) ? 1 : 2;
+		nod->split_val = (split%2 == 1) ? sorted[index_median].GetX() : sorted[index_median].GetY();
+		nod->is_leaf = false;
+		nod->data_leaf = Point2d(0,0);
+		nod->count = siz;
+		return index_median;
+	}
+	
+	/**
+	 *  @returns true if the point goes to the left subtree of the internal node
+	 */
+	static bool GoesLeft(const Point2d& poi, const Node* nod)
+	{
+		return ((nod->split_coord == 1) ? poi.GetX() : poi.GetY()) <= nod->split_val;
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the BuildTree, it makes the internal node of a set of 
+	 *  at least 2 points and it splits the two sortings of the set, the parameters are the same.
+	 *  @returns the number of the points of the left subtree
+	 */
+	static int SplitNode(int split, Point2d* points_by_x, Point2d* points_by_y, Point2d* scratch, int siz, Node* nod)
+	{
+		int index_median = InitInternalNode(split,points_by_x,points_by_y,siz,nod);
+		Point2d* other = (split%2 == 1) ? points_by_y : points_by_x;
+		//the points of the other sorting that go left are moved forward in place, the rest wait 
+		//in the scratch and they are put after them
+		int num_left = 0;
+		int num_right = 0;
+		for( int i = 0; i < siz; i++ )
+		{
+			if( GoesLeft(other[i],nod) )
+			{
+				other[num_left++] = other[i];
+			}else
+			{
+				scratch[num_right++] = other[i];
+			}
+		}
+		assert( num_left == index_median+1 );
+		std::copy(scratch,scratch+num_right,other+num_left);
+		nod->left = nod+1;
+		nod->right = nod+2*num_left;
+		return num_left;
+	}
+	
+	/**
+	 *  The parallel construction, it is the BuildTree but the two subtrees of a node are made by two 
+	 *  threads. The threads are shared to the subtrees until every subtree has one thread or less 
+	 *  than PARALLEL_GRAIN points, then the BuildTree makes it. A node with many threads is split by
+	 *  all of them with the SplitNodeParallel. The nodes of every subtree are known 
+	 *  from the start (preorder) and the subtrees use different parts of the arrays, so the threads 
+	 *  don't need any synchronization.
+	 *  @param num_threads the number of the threads for the subtree of the "nod"
+	 */
+	static void BuildTreeParallel(int split, Point2d* points_by_x, Point2d* points_by_y, Point2d* scratch, int siz, Node* nod,
+	                              unsigned int num_threads)
+	{
+		if( num_threads <= 1 || siz < PARALLEL_GRAIN )
+		{
+			BuildTree(split,points_by_x,points_by_y,scratch,siz,nod);
+			return;
+		}
+		int num_left = SplitNodeParallel(split,points_by_x,points_by_y,scratch,siz,nod,num_threads);
+		unsigned int left_threads = num_threads/2;
+		//the group joins the left thread also if the right subtree throws
+		thread_group threads;
+		threads.run(std::bind(BuildTreeParallel,split+1,points_by_x,points_by_y,scratch,num_left,nod->left,left_threads));
+		BuildTreeParallel(split+1,points_by_x+num_left,points_by_y+num_left,scratch+num_left,siz-num_left,nod->right,
+		                  num_threads-left_threads);
+		threads.join();
+	}
+	
+	/**
+	 *  The below is the work of one thread of the SplitNodeParallel, it counts the points from first 
+	 *  to last that go to the left subtree of the node.
+	 */
+	static void CountLeft(const Point2d* first, const Point2d* last, const Node* nod, int* num_left)
+	{
+		*num_left = 0;
+		for( ; first != last; ++first )
+		{
+			*num_left += GoesLeft(*first,nod);
+		}
+	}
+	
+	/**
+	 *  The below is the work of one thread of the SplitNodeParallel, it writes the points from first
+	 *  to last that go left to the left_out and the rest to the right_out keeping their order.
+	 */
+	static void ScatterPart(const Point2d* first, const Point2d* last, const Node* nod, Point2d* left_out, Point2d* right_out)
+	{
+		for( ; first != last; ++first )
+		{
+			if( GoesLeft(*first,nod) )
+			{
+				*left_out++ = *first;
+			}else
+			{
+				*right_out++ = *first;
+			}
+		}
+	}
+	
+	/**
+	 *  The below is the work of one thread of the SplitNodeParallel, it copies the points from first
+	 *  to last to the out.
+	 */
+	static void CopyPart(const Point2d* first, const Point2d* last, Point2d* out)
+	{
+		std::copy(first,last,out);
+	}
+	
+	/**
+	 *  It is the SplitNode with many threads, for the nodes near the root where one thread would
+	 *  pass over all the points alone. The stable partition of the other sorting is made in three
+	 *  parallel passes over parts of the points : the points of every part that go left are counted,
+	 *  every part writes its points to their positions in the scratch (known from the counts of the
+	 *  previous parts) and the scratch is copied back. The result is the same as the SplitNode.
+	 *  @param num_threads the number of the threads
+	 */
+	static int SplitNodeParallel(int split, Point2d* points_by_x, Point2d* points_by_y, Point2d* scratch, int siz, Node* nod,
+	                             unsigned int num_threads)
+	{
+		int num_parts = std::min<int>(num_threads,siz/PARALLEL_GRAIN);
+		if( num_parts <= 1 )
+		{
+			return SplitNode(split,points_by_x,points_by_y,scratch,siz,nod);
+		}
+		int index_median = InitInternalNode(split,points_by_x,points_by_y,siz,nod);
+		Point2d* other = (split%2 == 1) ? points_by_y : points_by_x;
+		std::vector<int> bounds(num_parts+1);
+		std::vector<int> counts(num_parts);
+		for( int i = 0; i <= num_parts; i++ )
+		{
+			bounds[i] = (long long)siz*i/num_parts;
+		}
+		thread_group threads;
+		for( int i = 0; i < num_parts; i++ )
+		{
+			threads.run(std::bind(CountLeft,other+bounds[i],other+bounds[i+1],nod,&counts[i]));
+		}
+		threads.join();
+		int num_left = 0;
+		for( int i = 0; i < num_parts; i++ )
+		{
+			num_left += counts[i];
+		}
+		assert( num_left == index_median+1 );
+		int left_before = 0;
+		for( int i = 0; i < num_parts; i++ )
+		{
+			int right_before = bounds[i] - left_before;
+			threads.run(std::bind(ScatterPart,other+bounds[i],other+bounds[i+1],nod,scratch+left_before,
+			                      scratch+num_left+right_before));
+			left_before += counts[i];
+		}
+		threads.join();
+		for( int i = 0; i < num_parts; i++ )
+		{
+			threads.run(std::bind(CopyPart,scratch+bounds[i],scratch+bounds[i+1],other+bounds[i]));
+		}
+		threads.join();
+		nod->left = nod+1;
+		nod->right = nod+2*num_left;
+		return num_left;
+	}
+	
+	/**
+	 *  The below is the work of one thread of the ParallelSort, it sorts the points from first to last
+	 *  with respect to x coordinate (by_x is true) or to y coordinate.
+	 */
+	static void SortPart(Point2d* first, Point2d* last, bool by_x)
+	{
+		std::sort(first,last,by_x ? comp_func_by_x : comp_func_by_y);
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the MergeChunk, it finds with a binary search how many
+	 *  of the first k points of the stable merge of the sorted a and b come from the a.
+	 */
+	static std::size_t MergeSplit(const Point2d* a, std::size_t siz_a, const Point2d* b, std::size_t siz_b, std::size_t k,
+	                              bool by_x)
+	{
+		bool (*comp)(Point2d,Point2d) = by_x ? comp_func_by_x : comp_func_by_y;
+		std::size_t low = (k > siz_b) ? k - siz_b : 0;
+		std::size_t high = std::min(k,siz_a);
+		while( low < high )
+		{
+			std::size_t mid = (low+high)/2;
+			//the a[mid] goes before the b[k-mid-1] if it isn't greater, then more points come from a
+			if( !comp(b[k-mid-1],a[mid]) )
+			{
+				low = mid+1;
+			}else
+			{
+				high = mid;
+			}
+		}
+		return low;
+	}
+	
+	/**
+	 *  The below is the work of one thread of the ParallelSort, it writes the points from the position
+	 *  k_first to the k_last of the stable merge of the sorted a and b to the same positions of out.
+	 */
+	static void MergeChunk(const Point2d* a, std::size_t siz_a, const Point2d* b, std::size_t siz_b, Point2d* out,
+	                       std::size_t k_first, std::size_t k_last, bool by_x)
+	{
+		std::size_t a_first = MergeSplit(a,siz_a,b,siz_b,k_first,by_x);
+		std::size_t a_last = MergeSplit(a,siz_a,b,siz_b,k_last,by_x);
+		std::merge(a+a_first,a+a_last,b+(k_first-a_first),b+(k_last-a_last),out+k_first,
+		           by_x ? comp_func_by_x : comp_func_by_y);
+	}
+	
+	/**
+	 *  It sorts the points with many threads : every thread sorts a part of the points and then the 
+	 *  sorted parts are merged in pairs from the points to a buffer and back. Every merge is split to
+	 *  chunks of its output, so all the threads work also at the last rounds where there are few 
+	 *  merges. The merges are stable, the result is the same for any number of threads.
+	 *  @param points the points
+	 *  @param by_x true to sort with respect to x coordinate, false for the y coordinate
+	 *  @param num_threads the number of the threads
+	 */
+	static void ParallelSort(std::vector<Point2d>* points, bool by_x, unsigned int num_threads)
+	{
+		std::size_t siz = points->size();
+		std::size_t num_parts = std::min<std::size_t>(num_threads,siz/PARALLEL_GRAIN);
+		if( num_parts <= 1 )
 		{
-			if(split%2 == 1)
+			SortPart(points->data(),points->data()+siz,by_x);
+			return;
+		}
+		std::vector<std::size_t> bounds(num_parts+1);
+		for( std::size_t i = 0; i <= num_parts; i++ )
+		{
+			bounds[i] = siz*i/num_parts;
+		}
+		thread_group threads;
+		for( std::size_t i = 0; i < num_parts; i++ )
+		{
+			threads.run(std::bind(SortPart,points->data()+bounds[i],points->data()+bounds[i+1],by_x));
+		}
+		threads.join();
+		std::vector<Point2d> buffer(siz);
+		Point2d* src = points->data();
+		Point2d* dst = buffer.data();
+		for( std::size_t width = 1; width < num_parts; width *= 2 )
+		{
+			std::size_t num_merges = (num_parts + 2*width - 1)/(2*width);
+			std::size_t chunks = std::max<std::size_t>(1,num_threads/num_merges);
+			for( std::size_t i = 0; i < num_parts; i += 2*width )
 			{
-				//then we split by x coordinate
-				
-				int index_median = ceil(siz/2.0)-1;
-				Point2d split_point = points_by_x[index_median];
-				for(int i = 0; i < siz; i++)
+				//the last part of a round may have no pair, then it is only copied
+				std::size_t first = bounds[i];
+				std::size_t middle = bounds[std::min(i+width,num_parts)];
+				std::size_t last = bounds[std::min(i+2*width,num_parts)];
+				for( std::size_t c = 0; c < chunks; c++ )
 				{
-					if( i <= index_median )
-					{
-						left_by_x.push_back(points_by_x[i]);
-					}else
-					{
-						right_by_x.push_back(points_by_x[i]);
-					}
-					if( points_by_y[i].GetX() <= split_point.GetX() )
-					{
-						left_by_y.push_back(points_by_y[i]);
-					}else
-					{
-						right_by_y.push_back(points_by_y[i]);
-					}
+					threads.run(std::bind(MergeChunk,src+first,middle-first,src+middle,last-middle,dst+first,
+					                      (last-first)*c/chunks,(last-first)*(c+1)/chunks,by_x));
 				}
-				
-				nod->left = BuildTree(split+1,left_by_x,left_by_y);
-				nod->right = BuildTree(split+1,right_by_x,right_by_y);
-				nod->split_coord = 1;
-				nod->split_val = split_point.GetX();
-				nod->is_leaf = false;
-				return nod;
-			}else
+			}
+			threads.join();
+			std::swap(src,dst);
+		}
+		if( src != points->data() )
+		{
+			points->swap(buffer);
+		}
+	}
+	
+	/**
+	 *  It makes the nodes of the tree from the sort_by_x and the sort_by_y. All the memory is taken 
+	 *  at once : the 2*n-1 nodes in one array and three arrays of n points for the construction.
+	 *  @param num_threads the number of the threads of the construction
+	 */
+	void BuildNodes(unsigned int num_threads = 1)
+	{
+		my_nodes.clear();
+		root = 0;
+		int siz = sort_by_x.size();
+		if( siz == 0 )
+		{
+			return;
+		}
+		my_nodes.resize(2*siz-1);
+		std::vector<Point2d> points_by_x(sort_by_x);
+		std::vector<Point2d> points_by_y(sort_by_y);
+		std::vector<Point2d> scratch(siz);
+		root = &my_nodes[0];
+		BuildTreeParallel(1,&points_by_x[0],&points_by_y[0],&scratch[0],siz,root,num_threads);
+	}
+	
+	/**
+	 *  It makes the children of the nodes to point to the nodes of this tree after the nodes were 
+	 *  copied from an other tree.
+	 *  @param other_root the root of the other tree
+	 */
+	void RelinkNodes(const Node* other_root)
+	{
+		root = my_nodes.empty() ? 0 : &my_nodes[0];
+		for( std::size_t i = 0; i < my_nodes.size(); i++ )
+		{
+			if( !my_nodes[i].is_leaf )
+			{
+				my_nodes[i].left = root + (my_nodes[i].left - other_root);
+				my_nodes[i].right = root + (my_nodes[i].right - other_root);
+			}
+		}
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the range search, it writes the points of all the leaves
+	 *  that are descendants of the "nod" without any check.
+	 *  @returns the output iterator after the last point that was written
+	 */
+	template <class OutputIterator>
+	static OutputIterator reportSubtree(const Node* nod, OutputIterator out)
+	{
+		while( !nod->is_leaf )
+		{
+			out = reportSubtree(nod->left,out);
+			nod = nod->right;
+		}
+		*out = nod->data_leaf;
+		++out;
+		return out;
+	}
+	
+	/**
+	 *  @returns true if the region is inside the query rectangle, the minimums of the region are not
+	 *  included in it
+	 */
+	static bool insideQuery(const Box& region, const Box& query)
+	{
+		return region.xmin >= query.xmin && region.xmax <= query.xmax && 
+		       region.ymin >= query.ymin && region.ymax <= query.ymax;
+	}
+	
+	/**
+	 *  @returns true if the point is inside the query rectangle or on its boundary
+	 */
+	static bool insideQuery(const Point2d& poi, const Box& query)
+	{
+		return query.xmin <= poi.GetX() && poi.GetX() <= query.xmax && 
+		       query.ymin <= poi.GetY() && poi.GetY() <= query.ymax;
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the range search and of the range count. It goes down to
+	 *  the children of the "nod" whose regions meet the query rectangle, a subtree whose region is inside 
+	 *  the query is reported (or counted) whole and a leaf is checked.
+	 *  @param nod the node
+	 *  @param region the region of the "nod", the points of its subtree are inside it
+	 *  @param query the query rectangle
+	 *  @param out the output iterator of the points, it is not used if count_only is true
+	 *  @param counter at the end it is increased by the number of the points of the subtree inside the query
+	 *  @param count_only true for the range count, false for the range search
+	 *  @returns the output iterator after the last point that was written
+	 */
+	template <class OutputIterator>
+	static OutputIterator searchSubtree(const Node* nod, Box region, const Box& query, OutputIterator out,
+	                                    unsigned int& counter, bool count_only)
+	{
+		if( nod->is_leaf )
+		{
+			if( insideQuery(nod->data_leaf,query) )
 			{
-				//then we split by y coordinate
-				
-				int index_median = ceil(siz/2.0)-1;
-				Point2d split_point = points_by_y[index_median];
-				for(int i = 0; i < siz; i++)
+				counter++;
+				if( !count_only )
 				{
-					if( i <= index_median )
-					{
-						left_by_y.push_back(points_by_y[i]);
-					}else
-					{
-						right_by_y.push_back(points_by_y[i]);
-					}
-					if( points_by_x[i].GetY() <= split_point.GetY() )
-					{
-						left_by_x.push_back(points_by_x[i]);
-					}else
-					{
-						right_by_x.push_back(points_by_x[i]);
-					}
+					*out = nod->data_leaf;
+					++out;
 				}
-				
-				nod->left = BuildTree(split+1,left_by_x,left_by_y);
-				nod->right = BuildTree(split+1,right_by_x,right_by_y);
-				nod->split_coord = 2;
-				nod->split_val = split_point.GetY();
-				nod->is_leaf = false;
-				return nod;
 			}
+			return out;
 		}
+		if( insideQuery(region,query) )
+		{
+			counter += nod->count;
+			return count_only ? out : reportSubtree(nod,out);
+		}
+		//the left child has the points with coordinate less than or equal to the split value and the
+		//right child the points with coordinate greater than it
+		Box left_region = region;
+		Box right_region = region;
+		bool go_left;
+		bool go_right;
+		if( nod->split_coord == 1 )
+		{
+			left_region.xmax = nod->split_val;
+			right_region.xmin = nod->split_val;
+			go_left = nod->split_val >= query.xmin;
+			go_right = nod->split_val < query.xmax;
+		}else
+		{
+			left_region.ymax = nod->split_val;
+			right_region.ymin = nod->split_val;
+			go_left = nod->split_val >= query.ymin;
+			go_right = nod->split_val < query.ymax;
+		}
+		if( go_left )
+		{
+			out = searchSubtree(nod->left,left_region,query,out,counter,count_only);
+		}
+		if( go_right )
+		{
+			out = searchSubtree(nod->right,right_region,query,out,counter,count_only);
+		}
+		return out;
+	}
+	
+	/**
+	 *  A point of the k nearest neighbours with the square of its distance from the query point.
+	 */
+	struct Neighbour{
+		double dist2;
+		Point2d poi;
+		bool operator<(const Neighbour& other) const {return dist2 < other.dist2;}
+	};
+	
+	/**
+	 *  @returns the square of the distance of two points, without the sqrt and the pow of the 
+	 *  Point2d::Distanceof2dPoints
+	 */
+	static double squaredDistance(const Point2d& p1, const Point2d& p2)
+	{
+		double d_x = p1.GetX() - p2.GetX();
+		double d_y = p1.GetY() - p2.GetY();
+		return d_x*d_x + d_y*d_y;
 	}
 	
 	/**
-	 *  The below is an auxiliary function for the deletion of all the nodes 
-	 *  of the  tree. Starting from the "node" returns all the node that 
-	 *  are descendants of the "node" and the "node" itself.
-	 *  @returns a vector that contains the "node" and all of its descendants.
-	 *  @param node the pointer to the node of the tree that we start to 
-	 *  find the descendants
+	 *  The below is an auxiliary function of the nearest. It goes down first to the child of the "nod"
+	 *  at the side of the query point and then to the other child only if the plane of the split is 
+	 *  nearer than the farthest of the k nearest points that were found.
+	 *  @param heap the nearest points that were found, it is a max-heap of at most k points
 	 */
-	std::vector<Node*> getAllNodes(Node* node)
+	static void nearestSubtree(const Node* nod, const Point2d& query_po, unsigned int k, std::vector<Neighbour>& heap)
 	{
-		std::vector<Node*> vec;
-		vec.push_back(node);
-		if( node->left != 0 )
+		if( nod->is_leaf )
 		{
-			std::vector<Node*> vec_left = getAllNodes(node->left);
-			for(std::vector<Node*>::iterator it = vec_left.begin(); it != vec_left.end(); it++)
+			Neighbour nei;
+			nei.dist2 = squaredDistance(nod->data_leaf,query_po);
+			nei.poi = nod->data_leaf;
+			if( heap.size() < k )
 			{
-				vec.push_back(*it);
+				heap.push_back(nei);
+				std::push_heap(heap.begin(),heap.end());
+			}else if( nei.dist2 < heap.front().dist2 )
+			{
+				std::pop_heap(heap.begin(),heap.end());
+				heap.back() = nei;
+				std::push_heap(heap.begin(),heap.end());
 			}
+			return;
 		}
-		if( node->right != 0 )
+		double diff = (nod->split_coord == 1 ? query_po.GetX() : query_po.GetY()) - nod->split_val;
+		const Node* near_child = (diff <= 0) ? nod->left : nod->right;
+		const Node* far_child = (diff <= 0) ? nod->right : nod->left;
+		nearestSubtree(near_child,query_po,k,heap);
+		if( heap.size() < k || diff*diff < heap.front().dist2 )
 		{
-			std::vector<Node*> vec_right = getAllNodes(node->right);
-			for(std::vector<Node*>::iterator it = vec_right.begin(); it != vec_right.end(); it++)
+			nearestSubtree(far_child,query_po,k,heap);
+		}
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the withinRadius, it goes down only to the children of 
+	 *  the "nod" whose side of the plane of the split is not farther than the radius.
+	 *  @param radius2 the square of the radius
+	 *  @param res the points that were found
+	 */
+	static void radiusSubtree(const Node* nod, const Point2d& query_po, double radius2, std::vector<Point2d>& res)
+	{
+		while( !nod->is_leaf )
+		{
+			double diff = (nod->split_coord == 1 ? query_po.GetX() : query_po.GetY()) - nod->split_val;
+			const Node* near_child = (diff <= 0) ? nod->left : nod->right;
+			const Node* far_child = (diff <= 0) ? nod->right : nod->left;
+			if( diff*diff <= radius2 )
 			{
-				vec.push_back(*it);
+				radiusSubtree(far_child,query_po,radius2,res);
 			}
+			nod = near_child;
+		}
+		if( squaredDistance(nod->data_leaf,query_po) <= radius2 )
+		{
+			res.push_back(nod->data_leaf);
 		}
-		return vec;
+	}
+	
+	/**
+	 *  The below is the work of one thread of the batch nearest and withinRadius, it answers the
+	 *  queries from start to stop.
+	 *  @param radius the radius of the withinRadius, it is used if k is 0
+	 */
+	static void batchPart(const K2d_tree* tree, const std::vector<Point2d>* queries, unsigned int k, double radius,
+	                      std::size_t start, std::size_t stop, std::vector< std::vector<Point2d> >* res)
+	{
+		for( std::size_t i = start; i < stop; i++ )
+		{
+			(*res)[i] = (k > 0) ? tree->nearest((*queries)[i],k) : tree->withinRadius((*queries)[i],radius);
+		}
+	}
+	
+	/**
+	 *  The below is an auxiliary function of the batch nearest and withinRadius, it shares the
+	 *  queries to the threads in parts of the same size.
+	 */
+	std::vector< std::vector<Point2d> > batchQueries(const std::vector<Point2d>& queries, unsigned int k, double radius,
+	                                                 unsigned int num_threads) const
+	{
+		std::vector< std::vector<Point2d> > res(queries.size());
+		if( num_threads == 0 )
+		{
+			num_threads = std::max(1u,std::thread::hardware_concurrency());
+		}
+		std::size_t num_parts = std::max<std::size_t>(1,std::min<std::size_t>(num_threads,queries.size()));
+		if( num_parts == 1 )
+		{
+			batchPart(this,&queries,k,radius,0,queries.size(),&res);
+			return res;
+		}
+		//the group joins the threads before an exception leaves and it throws the exceptions of the
+		//threads (a std::bad_alloc of the results) here, as the one thread does
+		thread_group threads;
+		for( std::size_t i = 0; i < num_parts; i++ )
+		{
+			threads.run(std::bind(batchPart,this,&queries,k,radius,queries.size()*i/num_parts,
+			                      queries.size()*(i+1)/num_parts,&res));
+		}
+		threads.join();
+		return res;
+	}
+	
+	/**
+	 *  @returns the region of the root, all the plane
+	 */
+	static Box wholePlane()
+	{
+		Box region;
+		region.xmin = -std::numeric_limits<double>::infinity();
+		region.xmax = std::numeric_limits<double>::infinity();
+		region.ymin = -std::numeric_limits<double>::infinity();
+		region.ymax = std::numeric_limits<double>::infinity();
+		return region;
 	}
 	
 	
@@ -250,15 +729,33 @@ public:
 	 *  then it throws exception because this case is unsupported yet.
 	 *  @param points the vector with the points to which the construction of the 
 	 *  K2d_tree is based.
+	 *  @param num_threads the number of the threads of the sorts and of the construction, if it is 0
+	 *  we use as many threads as the hardware supports. The two sorts run at the same time with the
+	 *  half of the threads each, see the ParallelSort and the BuildTreeParallel. The tree is the 
+	 *  same for any number of threads.
 	 *  
 	 */
-	K2d_tree(std::vector<Point2d> points)
+	K2d_tree(std::vector<Point2d> points, unsigned int num_threads = 0)
 	{
+		if( num_threads == 0 )
+		{
+			num_threads = std::max(1u,std::thread::hardware_concurrency());
+		}
 		// here must do the sort of points and call the Buildtree 
-		std::sort (points.begin(), points.end(), comp_func_by_x);
 		sort_by_x = points;
-		std::sort (points.begin(), points.end(), comp_func_by_y);
-		sort_by_y= points;
+		sort_by_y.swap(points);
+		if( num_threads == 1 )
+		{
+			ParallelSort(&sort_by_x,true,1);
+			ParallelSort(&sort_by_y,false,1);
+		}else
+		{
+			//the group joins the sort by x also if the sort by y throws
+			thread_group threads;
+			threads.run(std::bind(ParallelSort,&sort_by_x,true,num_threads/2));
+			ParallelSort(&sort_by_y,false,num_threads-num_threads/2);
+			threads.join();
+		}
 		
 		my_size = sort_by_x.size();
 		
@@ -281,23 +778,70 @@ public:
 			that have equal x coordinate or y coordinate\n" );
 		}else
 		{
-			root = BuildTree(1,sort_by_x,sort_by_y);
+			BuildNodes(num_threads);
 		}
 	}
 	
 	
 	/**
-	 *  The destructor is necessary to destruct all the nodes which were constructed
-	 *  by using the command "new".
+	 *  Copy Constructor, the nodes are copied in one array and their children are made to point 
+	 *  to the new nodes.
+	 */
+	K2d_tree(const K2d_tree& other_tree)
+	{
+		sort_by_x = other_tree.sort_by_x;
+		sort_by_y = other_tree.sort_by_y;
+		my_size = other_tree.my_size;
+		my_nodes = other_tree.my_nodes;
+		RelinkNodes(other_tree.root);
+	}
+	
+	
+	/**
+	 *  Move Constructor, it takes the nodes of the other_tree in O(1), the other_tree becomes empty.
+	 */
+	K2d_tree(K2d_tree&& other_tree) noexcept
+	{
+		root = 0;
+		my_size = 0;
+		swap(other_tree);
+	}
+	
+	
+	/**
+	 *  Assignment Operator, it copies the other_tree and swaps with the copy.
 	 */
-	~K2d_tree()
+	K2d_tree& operator=(const K2d_tree& other_tree)
 	{
-		//we have to get all the nodes that were created and delete them
-		std::vector<Node*> nodes = getAllNodes(root);
-		for(std::vector<Node*>::iterator it = nodes.begin(); it != nodes.end(); it++)
+		if( this != &other_tree )
 		{
-			delete *it;
+			K2d_tree tmp(other_tree);
+			swap(tmp);
 		}
+		return *this;
+	}
+	
+	
+	/**
+	 *  Move Assignment Operator, it swaps the nodes with the other_tree in O(1).
+	 */
+	K2d_tree& operator=(K2d_tree&& other_tree) noexcept
+	{
+		swap(other_tree);
+		return *this;
+	}
+	
+	
+	/**
+	 *  It swaps two trees in O(1), the tree_iterators follow the nodes.
+	 */
+	void swap(K2d_tree& other_tree) noexcept
+	{
+		std::swap(root,other_tree.root);
+		my_nodes.swap(other_tree.my_nodes);
+		sort_by_x.swap(other_tree.sort_by_x);
+		sort_by_y.swap(other_tree.sort_by_y);
+		std::swap(my_size,other_tree.my_size);
 	}
 	
 	
@@ -312,46 +856,173 @@ public:
 	
 	
 	/**
-	 *  This method adding a point to the tree. The function first of all 
-	 *  deletes the current whole tree and then adds to the vectors points_by_x and points_by_y
-	 *  the new point. After it calls the BuildTree function as the K2d_tree(std::vector<Point2d> points)
-	 *  does.
+	 *  This method adding a point to the tree. The function adds to the vectors sort_by_x and 
+	 *  sort_by_y the new point in its position and then it makes the nodes again as the 
+	 *  K2d_tree(std::vector<Point2d> points) does, so the tree_iterators are not valid after it.
 	 *  @param poi the point that will be added to the tree.
+	 *  @throws std::runtime_error if a point of the tree has equal x coordinate or y coordinate
+	 *  with the poi, as the constructor does
 	 */
 	void addPoint(const Point2d poi) 
 	{
-		//firtst step we have to destroy all the old nodes
-		std::vector<Node*> nodes = getAllNodes(root);
-		for(std::vector<Node*>::iterator it = nodes.begin(); it != nodes.end(); it++)
+		//first step : we find the positions of the new point in the sort_by_x and sort_by_y
+		std::vector<Point2d>::iterator it_x = std::upper_bound(sort_by_x.begin(),sort_by_x.end(),poi,comp_func_by_x);
+		std::vector<Point2d>::iterator it_y = std::upper_bound(sort_by_y.begin(),sort_by_y.end(),poi,comp_func_by_y);
+		if( (it_x != sort_by_x.begin() && (it_x-1)->GetX() == poi.GetX()) ||
+		    (it_y != sort_by_y.begin() && (it_y-1)->GetY() == poi.GetY()) )
 		{
-			delete *it;
+			throw std::runtime_error( "The K2d_tree construction is unsupported for sets where exists points \
+			that have equal x coordinate or y coordinate\n" );
 		}
 		//second step : we have to add to the sort_by_x and sort_by_y the new point 
-		std::vector<Point2d>::iterator it = sort_by_x.begin();
-		while( it != sort_by_x.end() )
-		{
-			if( poi.GetX() <= (*it).GetX() )
-			{
-				sort_by_x.insert(it,poi);
-				break;
-			}
-			it++;
-		}
-		it = sort_by_y.begin();
-		while( it != sort_by_y.end() )
-		{
-			if( poi.GetY() <= (*it).GetY() )
-			{
-				sort_by_y.insert(it,poi);
-				break;
-			}
-			it++;
-		}
+		sort_by_x.insert(it_x,poi);
+		sort_by_y.insert(it_y,poi);
 		//the point that was added must increase the size of the tree
 		my_size++;
 		
 		//third step rebuild the tree with the calling of the BuildTree
-		root = BuildTree(1,sort_by_x,sort_by_y);
+		BuildNodes();
+	}
+	
+	/**
+	 *  The orthogonal range search, it finds the points of the tree inside the rectangle 
+	 *  [xmin,xmax] x [ymin,ymax] (the boundary is included) in O(sqrt(n) + k) where k is the number 
+	 *  of the points that are found. The subtrees whose regions are inside the rectangle are 
+	 *  reported without any check.
+	 *  @returns the points inside the rectangle
+	 */
+	std::vector<Point2d> rangeSearch(double xmin, double xmax, double ymin, double ymax) const
+	{
+		std::vector<Point2d> res;
+		rangeSearch(xmin,xmax,ymin,ymax,std::back_inserter(res));
+		return res;
+	}
+	
+	/**
+	 *  The orthogonal range search that writes the points to an output iterator, so it doesn't 
+	 *  allocate anything, see rangeSearch.
+	 *  @param out the output iterator, a Point2d is written to it for every point inside the rectangle
+	 *  @returns the output iterator after the last point that was written
+	 */
+	template <class OutputIterator>
+	OutputIterator rangeSearch(double xmin, double xmax, double ymin, double ymax, OutputIterator out) const
+	{
+		if( root == 0 )
+		{
+			return out;
+		}
+		Box query;
+		query.xmin = xmin;
+		query.xmax = xmax;
+		query.ymin = ymin;
+		query.ymax = ymax;
+		unsigned int counter = 0;
+		return searchSubtree(root,wholePlane(),query,out,counter,false);
+	}
+	
+	/**
+	 *  The orthogonal range count, it counts the points of the tree inside the rectangle 
+	 *  [xmin,xmax] x [ymin,ymax] (the boundary is included) in O(sqrt(n)). Every node keeps the 
+	 *  number of the points of its subtree, so the subtrees whose regions are inside the rectangle 
+	 *  are counted without walking them.
+	 *  @returns the number of the points inside the rectangle
+	 */
+	unsigned int rangeCount(double xmin, double xmax, double ymin, double ymax) const
+	{
+		if( root == 0 )
+		{
+			return 0;
+		}
+		Box query;
+		query.xmin = xmin;
+		query.xmax = xmax;
+		query.ymin = ymin;
+		query.ymax = ymax;
+		unsigned int counter = 0;
+		searchSubtree(root,wholePlane(),query,(Point2d*)0,counter,true);
+		return counter;
+	}
+	
+	/**
+	 *  The k nearest neighbours of a point. The tree is searched with branch and bound : the k nearest 
+	 *  points that were found are kept in a max-heap and a subtree at the other side of the plane of a 
+	 *  split is searched only if the plane is nearer than the farthest of them. The distances are 
+	 *  compared squared.
+	 *  @param query_po the query point
+	 *  @param k the number of the neighbours
+	 *  @returns the k nearest points of the tree (all the points if they are less than k) from the 
+	 *  nearest to the farthest
+	 */
+	std::vector<Point2d> nearest(const Point2d& query_po, unsigned int k) const
+	{
+		std::vector<Point2d> res;
+		if( root == 0 || k == 0 )
+		{
+			return res;
+		}
+		std::vector<Neighbour> heap;
+		heap.reserve(std::min(k,my_size));
+		nearestSubtree(root,query_po,k,heap);
+		std::sort_heap(heap.begin(),heap.end());
+		res.reserve(heap.size());
+		for( std::size_t i = 0; i < heap.size(); i++ )
+		{
+			res.push_back(heap[i].poi);
+		}
+		return res;
+	}
+	
+	/**
+	 *  The k nearest neighbours of many points, the queries are shared to the threads.
+	 *  @param num_threads the number of the threads, if it is 0 we use as many threads as the hardware supports
+	 *  @returns the k nearest points of every query point, see nearest
+	 */
+	std::vector< std::vector<Point2d> > nearest(const std::vector<Point2d>& queries, unsigned int k,
+	                                            unsigned int num_threads = 0) const
+	{
+		if( k == 0 )
+		{
+			return std::vector< std::vector<Point2d> >(queries.size());
+		}
+		return batchQueries(queries,k,0,num_threads);
+	}
+	
+	/**
+	 *  The fixed radius search, it finds the points of the tree whose distance from a point is less than 
+	 *  or equal to the radius. A subtree at the other side of the plane of a split is searched only if 
+	 *  the plane is not farther than the radius, the distances are compared squared.
+	 *  @param query_po the query point
+	 *  @param radius the radius
+	 *  @returns the points inside the circle, in no certain order
+	 */
+	std::vector<Point2d> withinRadius(const Point2d& query_po, double radius) const
+	{
+		std::vector<Point2d> res;
+		if( root != 0 && radius >= 0 )
+		{
+			radiusSubtree(root,query_po,radius*radius,res);
+		}
+		return res;
+	}
+	
+	/**
+	 *  The fixed radius search of many points, the queries are shared to the threads.
+	 *  @param num_threads the number of the threads, if it is 0 we use as many threads as the hardware supports
+	 *  @returns the points inside the circle of every query point, see withinRadius
+	 */
+	std::vector< std::vector<Point2d> > withinRadius(const std::vector<Point2d>& queries, double radius,
+	                                                 unsigned int num_threads = 0) const
+	{
+		return batchQueries(queries,0,radius,num_threads);
+	}
+	
+	/**
+	 * @returns the number of the bytes of the memory of the tree, the nodes and the two sortings of 
+	 * the points, see also the K2d_flat_tree
+	 */
+	std::size_t memoryFootprint() const
+	{
+		return sizeof(*this) + my_nodes.capacity()*sizeof(Node) + (sort_by_x.capacity() + sort_by_y.capacity())*sizeof(Point2d);
 	}
 	
 	/**
@@ -10,6 +10,8 @@
 #define DLC_LISTDEF
 #include <iostream>
 #include <cassert>
+#include <utility>
+#include "node_arena.hpp"
 
 
 template <class T> class dlc_list{
@@ -22,6 +24,50 @@ private:
 	Node* head;
 	unsigned int my_size;
 	double my_area;
+	node_arena my_own_arena; // the arena of the nodes if the user didn't give one
+	node_arena* my_arena;    // the arena of the nodes, my_own_arena or the arena of the user
+
+	/**
+	 * @returns a new node from the arena
+	 */
+	Node* new_node()
+	{
+		return new (my_arena->allocate(sizeof(Node))) Node;
+	}
+
+	/**
+	 * It gives back a node to the arena.
+	 */
+	void delete_node(Node* nod)
+	{
+		nod->~Node();
+		my_arena->deallocate(nod,sizeof(Node));
+	}
+
+	/**
+	 * It gives back all the nodes of the list to the arena.
+	 */
+	void delete_nodes()
+	{
+		if (head != 0)
+		{
+			Node* curr;
+			Node* last;
+			curr = head;
+			last = head->back;
+			while( curr != last )
+			{
+				Node* tmp = curr;
+				curr = curr->front;
+				//you should uncomment the below if you are running tests
+				//std::cout << "deletion : " << tmp->data <<  ", with address : " << tmp << "\n";
+				delete_node(tmp);
+			}
+			//you should uncomment the below if you are running tests
+			//std::cout << "deletion : " << last->data << ", with address : " << last << "\n"; 
+			delete_node(last);
+		}
+	}
 
 public:
 	class ch_iterator{
@@ -70,28 +116,33 @@ public:
 		
 	};
 
-	//default constructor
-	dlc_list() 
+	//default constructor, if the arena is 0 the list uses its own arena. The arena must live
+	//more than the list.
+	explicit dlc_list(node_arena* arena = 0) 
 	{
+		my_arena = (arena != 0) ? arena : &my_own_arena;
 		head = 0;
 		my_size = 0;
 		my_area = 0;
 	}
 	
 	
-	//copy constructor
+	//copy constructor, the copy uses the same arena as the other_ch if it is an arena of the 
+	//user, otherwise it uses its own arena
 	dlc_list(const dlc_list<T>& other_ch)
 	{
+		my_arena = (other_ch.my_arena != &other_ch.my_own_arena) ? other_ch.my_arena : &my_own_arena;
 		if(other_ch.my_size > 0)
 		{
+			my_arena->reserve(other_ch.my_size,sizeof(Node));
 			typename dlc_list<T>::ch_iterator curr_it(other_ch.begin());
-			Node* curr = new Node;
+			Node* curr = new_node();
 			curr->data = *curr_it;
 			head = curr;
 			Node* pre_curr = curr;
 			while(++curr_it != other_ch.head)
 			{
-				curr = new Node;
+				curr = new_node();
 				curr->data = *curr_it;
 				pre_curr->front = curr;
 				curr->back = pre_curr;
@@ -111,27 +162,11 @@ public:
 	}
 	
 	
-	//destructor
+	//destructor, the nodes go back to the arena without system calls, the own arena gives 
+	//back its slabs at once when it is destroyed
 	~dlc_list()
 	{
-		if (head != 0)
-		{
-			Node* curr;
-			Node* last;
-			curr = head;
-			last = head->back;
-			while( curr != last )
-			{
-				Node* tmp = curr;
-				curr = curr->front;
-				//you should uncomment the below if you are running tests
-				//std::cout << "deletion : " << tmp->data <<  ", with address : " << tmp << "\n";
-				delete tmp;
-			}
-			//you should uncomment the below if you are running tests
-			//std::cout << "deletion : " << last->data << ", with address : " << last << "\n"; 
-			delete last;
-		}
+		delete_nodes();
 	}
 	
 	//assignmnent operator
@@ -139,24 +174,10 @@ public:
 	{
 		if (this != &other_ch)
 		{
-			//firstly we have to delete the list that "this" holds, if "this" is 
-			//nonotherwise will have a memory leak 
-			if ( head!= 0 ) 
-			{
-				Node* curr;
-				Node* last;
-				curr = head;
-				last = head->back;
-				while( curr->front != last )
-				{
-					Node* tmp = curr;
-					curr = curr->front;
-					std::cout << "Deletion of the node with address : " << tmp << "\n";
-					delete tmp;
-				}
-				std::cout << "Deletion of the node with address : " << last << "\n";
-				delete last;
-			}
+			//firstly we have to delete the list that "this" holds, otherwise we will have 
+			//a memory leak. The nodes go back to the arena and the copy takes them again
+			delete_nodes();
+			my_arena->reserve(other_ch.my_size,sizeof(Node));
 			//the above was the last command of the deletion of the "this" list.
 				
 			//now we have the same list as the other_ch 
@@ -165,13 +186,13 @@ public:
 			// we can't iterate through the iterator we made because with this we can only access the 
 			// list not to modify. Here we make modification in order the nodes point where we want !!
 				typename dlc_list<T>::ch_iterator curr_it(other_ch.begin());
-				Node* curr = new Node;
+				Node* curr = new_node();
 				curr->data = *curr_it;
 				head = curr;
 				Node* pre_curr = curr;
 				while(++curr_it != other_ch.head)
 				{
-					curr = new Node;
+					curr = new_node();
 					curr->data = *curr_it;
 					pre_curr->front = curr;
 					curr->back = pre_curr;
@@ -192,6 +213,43 @@ public:
 		return *this;
 	}
 	
+	//move constructor, it takes the nodes of the other_ch in O(1), the other_ch becomes empty
+	dlc_list(dlc_list<T>&& other_ch) noexcept
+	{
+		my_arena = &my_own_arena;
+		head = 0;
+		my_size = 0;
+		my_area = 0;
+		swap(other_ch);
+	}
+	
+	//move assignment operator, it takes the nodes of the other_ch in O(1) and the other_ch 
+	//takes the nodes of "this" and frees them. "this" uses the arena of the other_ch after it
+	dlc_list<T>& operator=(dlc_list<T>&& other_ch) noexcept
+	{
+		if (this != &other_ch)
+		{
+			dlc_list<T> tmp(std::move(other_ch));
+			swap(tmp);
+		}
+		return *this;
+	}
+	
+	//it swaps two lists in O(1), every list keeps the arena of its nodes, the own arenas 
+	//are swapped with the nodes
+	void swap(dlc_list<T>& other_ch) noexcept
+	{
+		bool own = (my_arena == &my_own_arena);
+		bool other_own = (other_ch.my_arena == &other_ch.my_own_arena);
+		node_arena* arena = my_arena;
+		my_own_arena.swap(other_ch.my_own_arena);
+		my_arena = other_own ? &my_own_arena : other_ch.my_arena;
+		other_ch.my_arena = own ? &other_ch.my_own_arena : arena;
+		std::swap(head,other_ch.head);
+		std::swap(my_size,other_ch.my_size);
+		std::swap(my_area,other_ch.my_area);
+	}
+	
 
 	
 	unsigned int size() const
@@ -205,7 +263,7 @@ public:
 	 */
 	void push(T a) 
 	{
-		Node* tmp = new Node;
+		Node* tmp = new_node();
 		tmp->data = a;
 		if(my_size == 0)
 		{
@@ -242,5 +300,11 @@ public:
 	
 };
 
+//it swaps two lists in O(1), see dlc_list<T>::swap
+template <class T> void swap(dlc_list<T>& list_1, dlc_list<T>& list_2) noexcept
+{
+	list_1.swap(list_2);
+}
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,202 @@
+/**
+    Purpose: To allocate the nodes of the lists (dlc_list, CH2d_dlclist) from slabs of memory instead of
+    a new and a delete for every node. The memory is asked from the system in slabs of many nodes, a node
+    that is freed goes to a free list and the next allocation of the same size takes it from there, so
+    the copy, the destruction and the reconstruction of a list make O(1) system allocations. The memory
+    is given back to the system only when the arena is destroyed.
+    Every list has its own arena, but a list can use an arena of the user instead, for example one arena
+    for many lists that are made and destroyed in a loop. The arena must live more than the lists that
+    use it. It is not thread safe, every thread must use its own arena.
+
+    @author Chaviaras Michalis
+    @version 1.1  4/2018
+*/
+#ifndef NODE_ARENADEF
+#define NODE_ARENADEF
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+class node_arena{
+	struct free_node{
+		free_node* next;
+	};
+
+	/**
+	 * The nodes of one size, the lists use one or two sizes of nodes so an arena has few of them.
+	 */
+	struct size_class{
+		std::size_t size;       // the size of a node, a multiple of the alignment
+		free_node* free;        // the nodes that were freed
+		char* cur;              // the next node of the current slab that was never given
+		char* end;              // the end of the current slab
+		std::size_t next_slab;  // the number of the nodes of the next slab
+	};
+
+	// the first slab has this number of nodes and every next slab is double until the maximum
+	static const std::size_t MIN_SLAB_NODES = 64;
+	static const std::size_t MAX_SLAB_NODES = 1 << 16;
+
+	std::vector<void*> my_slabs;
+	std::vector<size_class> my_classes;
+
+	/**
+	 * @returns the size rounded up to a multiple of the alignment of every type
+	 */
+	static std::size_t aligned_size(std::size_t bytes)
+	{
+		const std::size_t align = alignof(std::max_align_t);
+		if( bytes < sizeof(free_node) )
+		{
+			bytes = sizeof(free_node);
+		}
+		return (bytes + align - 1)/align*align;
+	}
+
+	/**
+	 * @returns the size class of the size, it is made if it doesn't exist
+	 */
+	size_class& class_of(std::size_t bytes)
+	{
+		std::size_t siz = aligned_size(bytes);
+		for( std::size_t i = 0; i < my_classes.size(); i++ )
+		{
+			if( my_classes[i].size == siz )
+			{
+				return my_classes[i];
+			}
+		}
+		size_class cla;
+		cla.size = siz;
+		cla.free = 0;
+		cla.cur = 0;
+		cla.end = 0;
+		cla.next_slab = MIN_SLAB_NODES;
+		my_classes.push_back(cla);
+		return my_classes.back();
+	}
+
+	/**
+	 * It asks a new slab of num nodes from the system, the rest of the current slab goes to
+	 * the free list.
+	 */
+	void new_slab(size_class& cla, std::size_t num)
+	{
+		while( cla.cur != cla.end )
+		{
+			free_node* nod = reinterpret_cast<free_node*>(cla.cur);
+			nod->next = cla.free;
+			cla.free = nod;
+			cla.cur += cla.size;
+		}
+		char* slab = static_cast<char*>(::operator new(num*cla.size));
+		my_slabs.push_back(slab);
+		cla.cur = slab;
+		cla.end = slab + num*cla.size;
+	}
+
+	//the arena can't be copied, the lists keep pointers to it
+	node_arena(const node_arena&);
+	node_arena& operator=(const node_arena&);
+
+public:
+	/**
+	 *   Default Constructor, it doesn't allocate memory
+	 */
+	node_arena()
+	{
+	}
+
+	/**
+	 *   Destructor, it gives back all the memory to the system
+	 */
+	~node_arena()
+	{
+		for( std::size_t i = 0; i < my_slabs.size(); i++ )
+		{
+			::operator delete(my_slabs[i]);
+		}
+	}
+
+	/**
+	 * @param bytes the size of the node
+	 * @returns memory for a node, aligned for every type
+	 */
+	void* allocate(std::size_t bytes)
+	{
+		size_class& cla = class_of(bytes);
+		if( cla.free != 0 )
+		{
+			free_node* nod = cla.free;
+			cla.free = nod->next;
+			return nod;
+		}
+		if( cla.cur == cla.end )
+		{
+			new_slab(cla,cla.next_slab);
+			if( cla.next_slab < MAX_SLAB_NODES )
+			{
+				cla.next_slab *= 2;
+			}
+		}
+		void* res = cla.cur;
+		cla.cur += cla.size;
+		return res;
+	}
+
+	/**
+	 * It puts the node to the free list, it is not given back to the system.
+	 * @param ptr a node that was given from allocate of this arena
+	 * @param bytes the size of the node, the same with the allocate
+	 */
+	void deallocate(void* ptr, std::size_t bytes)
+	{
+		size_class& cla = class_of(bytes);
+		free_node* nod = static_cast<free_node*>(ptr);
+		nod->next = cla.free;
+		cla.free = nod;
+	}
+
+	/**
+	 * It makes sure that the next num allocations of this size will not ask memory from the
+	 * system, it asks at most one slab.
+	 * @param num the number of the nodes
+	 * @param bytes the size of the node
+	 */
+	void reserve(std::size_t num, std::size_t bytes)
+	{
+		size_class& cla = class_of(bytes);
+		std::size_t available = (cla.end - cla.cur)/cla.size;
+		for( free_node* nod = cla.free; nod != 0 && available < num; nod = nod->next )
+		{
+			available++;
+		}
+		if( available < num )
+		{
+			new_slab(cla,num - available);
+		}
+	}
+
+	/**
+	 * It swaps the memory of two arenas in O(1), the nodes that were given from one arena
+	 * belong to the other after it.
+	 */
+	void swap(node_arena& other_arena) noexcept
+	{
+		my_slabs.swap(other_arena.my_slabs);
+		my_classes.swap(other_arena.my_classes);
+	}
+
+	/**
+	 * @returns the number of the slabs that were asked from the system
+	 */
+	std::size_t slabs() const
+	{
+		return my_slabs.size();
+	}
+};
+
+
+#endif
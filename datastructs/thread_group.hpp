@@ -0,0 +1,114 @@
+/**
+    Purpose: To run the work of the parallel constructions (CH2d_dlclist, K2d_tree) in threads without
+    losing the process when something throws. A std::thread that is destroyed while it is joinable calls
+    std::terminate and an exception that leaves the function of a thread calls std::terminate too, so
+    the thread_group joins all its threads at its destruction and every function runs inside a try, the
+    first exception that was thrown in a thread is kept and the join() throws it again at the caller,
+    after all the threads have finished. So the parallel code throws (for example std::bad_alloc or the
+    std::system_error of a thread that couldn't start) as the sequential code does.
+    The programs that use it must be linked with the thread library (-pthread).
+
+    @author Chaviaras Michalis
+    @version 1.1  6/2018
+*/
+#ifndef THREAD_GROUPDEF
+#define THREAD_GROUPDEF
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class thread_group{
+private:
+	std::vector<std::thread> my_threads;
+	std::exception_ptr my_error;    // the first exception of a thread, null if nothing was thrown
+	std::mutex my_error_mutex;
+
+	/**
+	 * It is the function of every thread, it runs the work and it keeps the exception if it throws.
+	 */
+	template <class Function>
+	void work(Function func)
+	{
+		try
+		{
+			func();
+		}catch( ... )
+		{
+			std::lock_guard<std::mutex> lock(my_error_mutex);
+			if( !my_error )
+			{
+				my_error = std::current_exception();
+			}
+		}
+	}
+
+	//the threads have the address of the group, it can't be copied
+	thread_group(const thread_group&);
+	thread_group& operator=(const thread_group&);
+
+public:
+	thread_group() {}
+
+	/**
+	 * It joins the threads that are still running, an exception of them is lost. The join() must be
+	 * called to take it.
+	 */
+	~thread_group()
+	{
+		for( std::size_t i = 0; i < my_threads.size(); i++ )
+		{
+			if( my_threads[i].joinable() )
+			{
+				my_threads[i].join();
+			}
+		}
+	}
+
+	/**
+	 * It runs a function in a new thread.
+	 * @param func the function without arguments, for example a std::bind or a lambda
+	 * @throws std::system_error if the thread can't start, the threads that started keep running
+	 */
+	template <class Function>
+	void run(Function func)
+	{
+		//the place of the thread is reserved first, so it is never lost after the thread starts
+		my_threads.reserve(my_threads.size()+1);
+		my_threads.push_back(std::thread(&thread_group::work<Function>,this,func));
+	}
+
+	/**
+	 * It waits all the threads to finish.
+	 * @throws the first exception that was thrown in a thread
+	 */
+	void join()
+	{
+		for( std::size_t i = 0; i < my_threads.size(); i++ )
+		{
+			if( my_threads[i].joinable() )
+			{
+				my_threads[i].join();
+			}
+		}
+		my_threads.clear();
+		if( my_error )
+		{
+			std::exception_ptr error = my_error;
+			my_error = std::exception_ptr();
+			std::rethrow_exception(error);
+		}
+	}
+
+	/**
+	 * @returns the number of the threads that were started after the last join
+	 */
+	std::size_t size() const
+	{
+		return my_threads.size();
+	}
+};
+
+
+#endif